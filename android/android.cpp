@@ -17,6 +17,7 @@
 #include "logger/log.h"
 #include "zip/zip_file.h"
 #include "base/utils.h"
+#include "base/thread_pool.h"
 #include "common/bit.h"
 #include "common/elf.h"
 #include "android.h"
@@ -30,6 +31,7 @@
 #include "runtime/runtime.h"
 #include "runtime/image.h"
 #include "runtime/class_linker.h"
+#include "runtime/class_table.h"
 #include "runtime/indirect_reference_table.h"
 #include "runtime/vdex_file.h"
 #include "runtime/managed_stack.h"
@@ -48,6 +50,7 @@
 #include "runtime/gc/space/bump_pointer_space.h"
 #include "runtime/gc/accounting/space_bitmap.h"
 #include "runtime/jni/java_vm_ext.h"
+#include "runtime/jni/jni_env_ext.h"
 #include "runtime/oat/oat_file.h"
 #include "runtime/oat/stack_map.h"
 #include "runtime/interpreter/shadow_frame.h"
@@ -241,8 +244,10 @@ void Android::preLoad() {
     art::gc::space::LargeObjectSpace::Init();
     art::gc::space::BumpPointerSpace::Init();
     art::JavaVMExt::Init();
+    art::JNIEnvExt::Init();
     art::IndirectReferenceTable::Init();
     art::ClassLinker::Init();
+    art::ClassTable::Init();
     art::ArtMethod::Init();
     art::gc::accounting::ContinuousSpaceBitmap::Init();
     art::jit::Jit::Init();
@@ -393,14 +398,14 @@ void Android::ForeachObjects(std::function<bool (art::mirror::Object& object)> f
     ForeachObjects(fn, EACH_IMAGE_OBJECTS | EACH_ZYGOTE_OBJECTS | EACH_APP_OBJECTS | EACH_FAKE_OBJECTS, false);
 }
 
-void Android::ForeachObjects(std::function<bool (art::mirror::Object& object)> fn, int flag, bool check) {
+void Android::ForeachSpaces(std::function<void (art::gc::space::Space* space)> fn, int flag) {
     art::Runtime& runtime = art::Runtime::Current();
     art::gc::Heap& heap = runtime.GetHeap();
 
     auto walkfn = [&](art::gc::space::Space* space) {
         LOGD("Walk [%s] ...\n", space->GetName());
         if (space->IsVaildSpace()) {
-            space->Walk(fn, check);
+            fn(space);
         } else {
             LOGE("%s invalid space.\n", space->GetName());
         }
@@ -429,6 +434,38 @@ void Android::ForeachObjects(std::function<bool (art::mirror::Object& object)> f
     }
 }
 
+void Android::ForeachObjects(std::function<bool (art::mirror::Object& object)> fn, int flag, bool check) {
+    auto callback = [&](art::gc::space::Space* space) {
+        space->Walk(fn, check);
+    };
+    ForeachSpaces(callback, flag);
+}
+
+void Android::ParallelForeachObjects(std::function<void (uint32_t count)> prepare,
+                                     std::function<bool (uint32_t idx, art::mirror::Object& object)> fn,
+                                     std::function<void (uint32_t idx)> merge, int flag, bool check) {
+    std::vector<art::gc::space::Space::WalkPartition> partitions;
+    // more partitions than workers, keep workers busy on unbalanced regions.
+    uint32_t split = ThreadPool::GetWorkers() * 8;
+    auto callback = [&](art::gc::space::Space* space) {
+        space->Partition(partitions, split);
+    };
+    ForeachSpaces(callback, flag);
+
+    prepare(partitions.size());
+    auto task = [&](uint32_t idx) {
+        auto visitor = [&](art::mirror::Object& object) -> bool {
+            return fn(idx, object);
+        };
+        try {
+            partitions[idx](visitor, check);
+        } catch (InvalidAddressException e) {
+            LOGW("Partition(%d) walk exception!\n", idx);
+        }
+    };
+    ThreadPool::ForEach(partitions.size(), task, merge);
+}
+
 void Android::ForeachReferences(std::function<bool (art::mirror::Object& object)> fn) {
     ForeachReferences(fn, EACH_LOCAL_REFERENCES | EACH_GLOBAL_REFERENCES | EACH_WEAK_GLOBAL_REFERENCES);
 }
@@ -23,6 +23,7 @@
 #include "runtime/art_field.h"
 #include "runtime/art_method.h"
 #include "runtime/mirror/class.h"
+#include "runtime/gc/space/space.h"
 #include <stdint.h>
 #include <sys/types.h>
 #include <functional>
@@ -162,9 +163,37 @@ public:
      * image
      * fake
      */
+    static void ForeachSpaces(std::function<void (art::gc::space::Space* space)> fn, int flag);
     static void ForeachObjects(std::function<bool (art::mirror::Object& object)> fn);
     static void ForeachObjects(std::function<bool (art::mirror::Object& object)> fn, int flag, bool check);
 
+    /*
+     * Parallel walk, the heap is split into partitions ordered by address,
+     * prepare(count) is called first, fn(idx, object) runs on the workers,
+     * merge(idx) runs on the caller thread in partition order, so merged
+     * result is the same order as ForeachObjects.
+     */
+    static void ParallelForeachObjects(std::function<void (uint32_t count)> prepare,
+                                       std::function<bool (uint32_t idx, art::mirror::Object& object)> fn,
+                                       std::function<void (uint32_t idx)> merge, int flag, bool check);
+    template <typename T>
+    static void ParallelForeachObjects(std::function<bool (T& state, art::mirror::Object& object)> fn,
+                                       std::function<void (T& state)> merge, int flag, bool check) {
+        std::vector<std::unique_ptr<T>> states;
+        auto prepare = [&](uint32_t count) {
+            states.resize(count);
+        };
+        auto visitor = [&](uint32_t idx, art::mirror::Object& object) -> bool {
+            if (!states[idx]) states[idx] = std::make_unique<T>();
+            return fn(*states[idx], object);
+        };
+        auto finish = [&](uint32_t idx) {
+            if (states[idx]) merge(*states[idx]);
+            states[idx].reset();
+        };
+        ParallelForeachObjects(prepare, visitor, finish, flag, check);
+    }
+
     static constexpr int EACH_LOCAL_REFERENCES = 1 << 0;
     static constexpr int EACH_GLOBAL_REFERENCES = 1 << 1;
     static constexpr int EACH_WEAK_GLOBAL_REFERENCES = 1 << 2;
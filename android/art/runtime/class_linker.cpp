@@ -18,6 +18,8 @@
 #include "runtime/runtime.h"
 #include "runtime/entrypoints/runtime_asm_entrypoints.h"
 #include "android.h"
+#include "common/exception.h"
+#include <algorithm>
 
 struct ClassLinker_OffsetTable __ClassLinker_offset__;
 struct ClassLinker_SizeTable __ClassLinker_size__;
@@ -159,6 +161,65 @@ std::vector<std::unique_ptr<ClassLinker::DexCacheData>>& ClassLinker::GetDexCach
     return dex_caches_second_cache;
 }
 
+std::vector<std::unique_ptr<ClassTable>>& ClassLinker::GetClassTables() {
+    if (!class_tables_second_cache.empty())
+        return class_tables_second_cache;
+
+    std::vector<uint64_t> visited;
+    for (const auto& data : GetDexCacheDatas()) {
+        try {
+            uint64_t class_table = data->class_table();
+            if (!class_table || std::find(visited.begin(), visited.end(), class_table) != visited.end())
+                continue;
+            visited.push_back(class_table);
+
+            std::unique_ptr<ClassTable> table = std::make_unique<ClassTable>(class_table);
+            if (!table->Verify()) {
+                LOGD("ClassTable(0x%lx) layout mismatch.\n", class_table);
+                continue;
+            }
+            class_tables_second_cache.push_back(std::move(table));
+        } catch(InvalidAddressException e) {
+            // class loader unloaded or not dumped
+        }
+    }
+    return class_tables_second_cache;
+}
+
+std::vector<uint32_t>& ClassLinker::GetClasses() {
+    if (!classes_second_cache.empty())
+        return classes_second_cache;
+
+    for (const auto& table : GetClassTables()) {
+        try {
+            table->Visit([&](mirror::Class& klass) -> bool {
+                classes_second_cache.push_back(klass.Ptr());
+                return false;
+            });
+        } catch(InvalidAddressException e) {
+            LOGD("ClassTable(0x%lx) walk fail.\n", table->Ptr());
+        }
+    }
+
+    // a class is also recorded by its initiating loaders.
+    std::sort(classes_second_cache.begin(), classes_second_cache.end());
+    classes_second_cache.erase(std::unique(classes_second_cache.begin(), classes_second_cache.end()),
+                               classes_second_cache.end());
+    return classes_second_cache;
+}
+
+void ClassLinker::LookupClasses(const char* descriptor, std::vector<uint32_t>& classes) {
+    for (const auto& table : GetClassTables()) {
+        try {
+            mirror::Class klass = table->Lookup(descriptor);
+            if (klass.Ptr() && std::find(classes.begin(), classes.end(), klass.Ptr()) == classes.end())
+                classes.push_back(klass.Ptr());
+        } catch(InvalidAddressException e) {
+            LOGD("ClassTable(0x%lx) lookup fail.\n", table->Ptr());
+        }
+    }
+}
+
 bool ClassLinker::IsQuickGenericJniStub(uint64_t entry_point) {
     return entry_point && (entry_point == GetQuickGenericJniStub());
 }
@@ -21,6 +21,7 @@
 #include "cxx/list.h"
 #include "cxx/unordered_map.h"
 #include "runtime/mirror/dex_cache.h"
+#include "runtime/class_table.h"
 #include <vector>
 #include <memory>
 
@@ -75,6 +76,7 @@ public:
         static void Init33();
         inline uint64_t weak_root() { return VALUEOF(DexCacheData, weak_root); }
         inline uint64_t dex_file() { return VALUEOF(DexCacheData, dex_file); }
+        inline uint64_t class_table() { return VALUEOF(DexCacheData, class_table); }
 
         void InitCache(mirror::Object dex_cache, uint64_t dex_file) {
             dex_cache_cache = dex_cache;
@@ -92,11 +94,21 @@ public:
     cxx::list& GetDexCachesData();
     cxx::unordered_map& GetDexCachesData_v33();
     std::vector<std::unique_ptr<DexCacheData>>& GetDexCacheDatas();
+    /*
+     * Class tables of the boot class path and every class loader that
+     * registered a dex file, tables failing ClassTable::Verify are dropped.
+     */
+    std::vector<std::unique_ptr<ClassTable>>& GetClassTables();
+    // all classes of the class tables, sorted and unique.
+    std::vector<uint32_t>& GetClasses();
+    void LookupClasses(const char* descriptor, std::vector<uint32_t>& classes);
     bool IsQuickGenericJniStub(uint64_t entry_point);
     bool IsQuickResolutionStub(uint64_t entry_point);
     bool IsQuickToInterpreterBridge(uint64_t entry_point);
     void CleanCache() {
         dex_caches_second_cache.clear();
+        class_tables_second_cache.clear();
+        classes_second_cache.clear();
     }
 private:
     // quick memoryref cache
@@ -105,6 +117,8 @@ private:
 
     // second cache
     std::vector<std::unique_ptr<DexCacheData>> dex_caches_second_cache;
+    std::vector<std::unique_ptr<ClassTable>> class_tables_second_cache;
+    std::vector<uint32_t> classes_second_cache;
 };
 
 } //namespace art
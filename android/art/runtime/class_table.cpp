@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "api/core.h"
+#include "android.h"
+#include "common/exception.h"
+#include "runtime/class_table.h"
+#include "runtime/runtime_globals.h"
+#include <string.h>
+#include <string>
+
+struct ClassTable_OffsetTable __ClassTable_offset__;
+struct ClassSet_OffsetTable __ClassSet_offset__;
+struct ClassSet_SizeTable __ClassSet_size__;
+
+namespace art {
+
+// low bits of a TableSlot keep the descriptor hash.
+static constexpr uint32_t kHashMask = kObjectAlignment - 1;
+// ClassTable::FreezeSnapshot() appends one set per zygote fork.
+static constexpr uint64_t kMaxClassSets = 64;
+static constexpr uint64_t kMaxBuckets = 1 << 24;
+
+void ClassTable::Init() {
+    Android::RegisterSdkListener(Android::O, art::ClassTable::Init26);
+    Android::RegisterSdkListener(Android::P, art::ClassTable::Init28);
+    Android::RegisterSdkListener(Android::S, art::ClassTable::Init31);
+
+    Android::RegisterSdkListener(Android::O, art::ClassTable::ClassSet::Init26);
+}
+
+void ClassTable::Init26() {
+    if (CoreApi::Bits() == 64) {
+        __ClassTable_offset__ = {
+            .classes_ = 48,
+        };
+    } else {
+        __ClassTable_offset__ = {
+            .classes_ = 40,
+        };
+    }
+}
+
+void ClassTable::Init28() {
+    if (CoreApi::Bits() == 64) {
+        __ClassTable_offset__ = {
+            .classes_ = 40,
+        };
+    } else {
+        __ClassTable_offset__ = {
+            .classes_ = 32,
+        };
+    }
+}
+
+void ClassTable::Init31() {
+    if (CoreApi::Bits() == 64) {
+        __ClassTable_offset__ = {
+            .classes_ = 40,
+        };
+    } else {
+        __ClassTable_offset__ = {
+            .classes_ = 28,
+        };
+    }
+}
+
+void ClassTable::ClassSet::Init26() {
+    if (CoreApi::Bits() == 64) {
+        __ClassSet_offset__ = {
+            .num_elements_ = 8,
+            .num_buckets_ = 16,
+            .data_ = 40,
+        };
+
+        __ClassSet_size__ = {
+            .THIS = 64,
+        };
+    } else {
+        __ClassSet_offset__ = {
+            .num_elements_ = 4,
+            .num_buckets_ = 8,
+            .data_ = 20,
+        };
+
+        __ClassSet_size__ = {
+            .THIS = 40,
+        };
+    }
+}
+
+uint32_t ClassTable::ComputeModifiedUtf8Hash(const char* chars) {
+    uint32_t hash = 0;
+    while (*chars != '\0')
+        hash = hash * 31 + static_cast<uint8_t>(*chars++);
+    return hash;
+}
+
+cxx::vector& ClassTable::GetClassesCache() {
+    if (!classes_cache.Ptr()) {
+        classes_cache = classes();
+        classes_cache.copyRef(this);
+        classes_cache.SetEntrySize(SIZEOF(ClassSet));
+    }
+    return classes_cache;
+}
+
+bool ClassTable::Verify() {
+    cxx::vector& classes_ = GetClassesCache();
+    uint64_t begin = classes_.__begin();
+    uint64_t end = classes_.__end();
+    if (!begin || begin > end || end > classes_.__value()
+            || (end - begin) % SIZEOF(ClassSet)
+            || classes_.size() > kMaxClassSets)
+        return false;
+
+    for (const auto& value : classes_) {
+        ClassSet set(value, classes_);
+        if (!set.Verify())
+            return false;
+    }
+    return true;
+}
+
+void ClassTable::Visit(std::function<bool (mirror::Class& klass)> fn) {
+    for (const auto& value : GetClassesCache()) {
+        ClassSet set(value, classes_cache);
+        bool stop = false;
+        set.Visit([&](mirror::Class& klass) -> bool {
+            stop = fn(klass);
+            return stop;
+        });
+        if (stop)
+            break;
+    }
+}
+
+mirror::Class ClassTable::Lookup(const char* descriptor) {
+    uint32_t hash = ComputeModifiedUtf8Hash(descriptor);
+    for (const auto& value : GetClassesCache()) {
+        ClassSet set(value, classes_cache);
+        mirror::Class klass = set.Lookup(descriptor, hash);
+        if (klass.Ptr())
+            return klass;
+    }
+
+    // the descriptor hash has changed between releases, a miss on the
+    // probe sequence still has to compare every slot to be sure.
+    mirror::Class found = 0x0;
+    Visit([&](mirror::Class& klass) -> bool {
+        try {
+            std::string storage;
+            if (!strcmp(klass.GetDescriptor(&storage), descriptor))
+                found = klass;
+        } catch(InvalidAddressException e) {
+            // skip broken class
+        }
+        return found.Ptr() != 0x0;
+    });
+    return found;
+}
+
+bool ClassTable::ClassSet::Verify() {
+    uint64_t elements = num_elements();
+    uint64_t buckets = num_buckets();
+    if (elements > buckets || buckets > kMaxBuckets)
+        return false;
+    return !buckets || data();
+}
+
+void ClassTable::ClassSet::Visit(std::function<bool (mirror::Class& klass)> fn) {
+    uint64_t buckets = num_buckets();
+    if (!buckets)
+        return;
+
+    api::MemoryRef slots(data());
+    mirror::Object object_cache(0x0);
+    for (uint64_t i = 0; i < buckets; ++i) {
+        uint32_t slot = slots.value32Of(i * sizeof(uint32_t));
+        if (!slot)
+            continue;
+        mirror::Class klass(slot & ~kHashMask, object_cache);
+        if (!object_cache.Ptr()) {
+            object_cache = klass;
+            object_cache.Prepare(false);
+        }
+        if (fn(klass))
+            break;
+    }
+}
+
+mirror::Class ClassTable::ClassSet::Lookup(const char* descriptor, uint32_t hash) {
+    uint64_t buckets = num_buckets();
+    if (!buckets)
+        return 0x0;
+
+    // HashSet linear probing, an empty slot ends the chain.
+    api::MemoryRef slots(data());
+    uint64_t index = hash % buckets;
+    for (uint64_t probes = 0; probes < buckets; ++probes) {
+        uint32_t slot = slots.value32Of(index * sizeof(uint32_t));
+        if (!slot)
+            break;
+        if ((slot & kHashMask) == (hash & kHashMask)) {
+            try {
+                mirror::Class klass(slot & ~kHashMask);
+                std::string storage;
+                if (!strcmp(klass.GetDescriptor(&storage), descriptor))
+                    return klass;
+            } catch(InvalidAddressException e) {
+                // skip broken class
+            }
+        }
+        index = (index + 1 == buckets) ? 0 : index + 1;
+    }
+    return 0x0;
+}
+
+} //namespace art
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ANDROID_ART_RUNTIME_CLASS_TABLE_H_
+#define ANDROID_ART_RUNTIME_CLASS_TABLE_H_
+
+#include "api/memory_ref.h"
+#include "cxx/vector.h"
+#include "runtime/mirror/class.h"
+#include <functional>
+#include <vector>
+
+struct ClassTable_OffsetTable {
+    uint32_t classes_;
+};
+
+extern struct ClassTable_OffsetTable __ClassTable_offset__;
+
+struct ClassSet_OffsetTable {
+    uint32_t num_elements_;
+    uint32_t num_buckets_;
+    uint32_t data_;
+};
+
+struct ClassSet_SizeTable {
+    uint32_t THIS;
+};
+
+extern struct ClassSet_OffsetTable __ClassSet_offset__;
+extern struct ClassSet_SizeTable __ClassSet_size__;
+
+namespace art {
+
+class ClassTable : public api::MemoryRef {
+public:
+    ClassTable(uint64_t v) : api::MemoryRef(v) {}
+    ClassTable(const api::MemoryRef& ref) : api::MemoryRef(ref) {}
+    ClassTable(uint64_t v, api::MemoryRef& ref) : api::MemoryRef(v, ref) {}
+    ClassTable(uint64_t v, api::MemoryRef* ref) : api::MemoryRef(v, ref) {}
+
+    static void Init();
+    static void Init26();
+    static void Init28();
+    static void Init31();
+    inline uint64_t classes() { return Ptr() + OFFSET(ClassTable, classes_); }
+
+    // HashSet<TableSlot, ...>, a slot is a 32-bit class pointer with the
+    // low kObjectAlignment bits holding part of the descriptor hash.
+    class ClassSet : public api::MemoryRef {
+    public:
+        ClassSet(uint64_t v) : api::MemoryRef(v) {}
+        ClassSet(const api::MemoryRef& ref) : api::MemoryRef(ref) {}
+        ClassSet(uint64_t v, api::MemoryRef& ref) : api::MemoryRef(v, ref) {}
+        ClassSet(uint64_t v, api::MemoryRef* ref) : api::MemoryRef(v, ref) {}
+
+        static void Init26();
+        inline uint64_t num_elements() { return VALUEOF(ClassSet, num_elements_); }
+        inline uint64_t num_buckets() { return VALUEOF(ClassSet, num_buckets_); }
+        inline uint64_t data() { return VALUEOF(ClassSet, data_); }
+
+        bool Verify();
+        void Visit(std::function<bool (mirror::Class& klass)> fn);
+        mirror::Class Lookup(const char* descriptor, uint32_t hash);
+    };
+
+    /*
+     * Sanity check of the decoded layout, ClassTable offsets depend on the
+     * ReaderWriterMutex in front of it, don't trust a table that fails.
+     */
+    bool Verify();
+    void Visit(std::function<bool (mirror::Class& klass)> fn);
+    mirror::Class Lookup(const char* descriptor);
+    cxx::vector& GetClassesCache();
+    static uint32_t ComputeModifiedUtf8Hash(const char* chars);
+private:
+    // quick memoryref cache
+    cxx::vector classes_cache = 0x0;
+};
+
+} //namespace art
+
+#endif  // ANDROID_ART_RUNTIME_CLASS_TABLE_H_
@@ -18,6 +18,13 @@
 #include "android.h"
 #include "runtime/gc/accounting/space_bitmap.h"
 #include "runtime/runtime_globals.h"
+#include <string.h>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 struct ContinuousSpaceBitmap_OffsetTable __ContinuousSpaceBitmap_offset__;
 
@@ -25,6 +32,69 @@ namespace art {
 namespace gc {
 namespace accounting {
 
+/*
+ * Return the byte offset of the first 32-byte stride in [words, words + bytes)
+ * which has any bit set, rounded down to a stride, or the tail offset when
+ * fewer than 32 bytes remain. Callers scan the returned words one by one.
+ */
+#if defined(__aarch64__)
+
+static inline uint64_t SkipZeroWords(const uint8_t* words, uint64_t bytes) {
+    uint64_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        uint8x16_t v = vorrq_u8(vld1q_u8(words + i), vld1q_u8(words + i + 16));
+        if (vmaxvq_u8(v))
+            break;
+    }
+    return i;
+}
+
+#else
+
+static inline uint64_t SkipZeroWordsScalar(const uint8_t* words, uint64_t bytes) {
+    uint64_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        uint64_t w[4];
+        memcpy(w, words + i, sizeof(w));
+        if (w[0] | w[1] | w[2] | w[3])
+            break;
+    }
+    return i;
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2")))
+static uint64_t SkipZeroWordsAvx2(const uint8_t* words, uint64_t bytes) {
+    uint64_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        if (!_mm256_testz_si256(v, v))
+            break;
+    }
+    return i;
+}
+
+static bool HasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+static inline uint64_t SkipZeroWords(const uint8_t* words, uint64_t bytes) {
+    if (HasAvx2())
+        return SkipZeroWordsAvx2(words, bytes);
+    return SkipZeroWordsScalar(words, bytes);
+}
+
+#else
+
+static inline uint64_t SkipZeroWords(const uint8_t* words, uint64_t bytes) {
+    return SkipZeroWordsScalar(words, bytes);
+}
+
+#endif
+#endif
+
 void ContinuousSpaceBitmap::Init() {
     Android::RegisterSdkListener(Android::O, art::gc::accounting::ContinuousSpaceBitmap::Init26);
     Android::RegisterSdkListener(Android::Q, art::gc::accounting::ContinuousSpaceBitmap::Init29);
@@ -89,8 +159,47 @@ void ContinuousSpaceBitmap::VisitMarkedRange(uint64_t visit_begin, uint64_t visi
     //      #---- Bit of visit_begin
     //
 
+    // The bitmap words of [visit_begin, visit_end) are one contiguous
+    // mapping, resolve them to a host pointer once instead of bounds
+    // checking every word, fall back to valueOf() if they straddle blocks.
+    uint64_t index_count = index_end - index_start + (bit_end ? 1 : 0);
+    const uint8_t* words = nullptr;
+    api::MemoryRef words_ref(bitmap_begin_ref.Ptr() + index_start * point_bit, bitmap_begin_ref);
+    if (index_count && words_ref.IsValid()
+            && words_ref.Block()->virtualContains(words_ref.Ptr() + index_count * point_bit - 1))
+        words = reinterpret_cast<const uint8_t *>(words_ref.Real());
+
+    auto word_of = [&](uint64_t i) -> uint64_t {
+        if (words) {
+            if (point_bit == 8) {
+                uint64_t w;
+                memcpy(&w, words + (i - index_start) * 8, 8);
+                return w;
+            }
+            uint32_t w;
+            memcpy(&w, words + (i - index_start) * 4, 4);
+            return w;
+        }
+        return bitmap_begin_ref.valueOf((i * point_bit));
+    };
+
+    // Iterate on the bits set in word `w`, from the least to the most significant bit.
+    auto visit_word = [&](uint64_t i, uint64_t w) {
+        uint64_t ptr_base = IndexToOffset(i, point_bit) + heap_begin_ref.Ptr();
+        do {
+            uint64_t shift = __builtin_ctzll(w);
+            mirror::Object obj(ptr_base + shift * kObjectAlignment, heap_begin_ref);
+            if (obj.IsNonLargeValid()) {
+                visitor(obj);
+            } else if (check) {
+                LOGE("0x%lx is bad object on [0x%lx, 0x%lx).\n", obj.Ptr(), visit_begin, visit_end);
+            }
+            w ^= (static_cast<uint64_t>(1)) << shift;
+        } while (w != 0);
+    };
+
     // Left edge.
-    uint64_t left_edge = bitmap_begin_ref.valueOf((index_start * point_bit));
+    uint64_t left_edge = index_count ? word_of(index_start) : 0;
     // Mark of lower bits that are not in range.
     left_edge &= ~((static_cast<uint64_t>(1) << bit_start) - 1);
 
@@ -101,37 +210,24 @@ void ContinuousSpaceBitmap::VisitMarkedRange(uint64_t visit_begin, uint64_t visi
         // Left edge != right edge.
 
         // Traverse left edge.
-        if (left_edge != 0) {
-            uint64_t ptr_base = IndexToOffset(index_start, point_bit) + heap_begin_ref.Ptr();
-            do {
-                uint64_t shift = __builtin_ctzll(left_edge);
-                mirror::Object obj(ptr_base + shift * kObjectAlignment, heap_begin_ref);
-                if (obj.IsNonLargeValid()) {
-                    visitor(obj);
-                } else if (check) {
-                    LOGE("0x%lx is bad object on [0x%lx, 0x%lx).\n", obj.Ptr(), visit_begin, visit_end);
-                }
-                left_edge ^= ((static_cast<uint64_t>(1)) << shift);
-            } while (left_edge != 0);
-        }
+        if (left_edge != 0)
+            visit_word(index_start, left_edge);
 
         // Traverse the middle, full part.
-        for (uint64_t i = index_start + 1; i < index_end; ++i) {
-            uint64_t w = bitmap_begin_ref.valueOf((i * point_bit));
-            if (w != 0) {
-                uint64_t ptr_base = IndexToOffset(i, point_bit) + heap_begin_ref.Ptr();
-                // Iterate on the bits set in word `w`, from the least to the most significant bit.
-                do {
-                    uint64_t shift = __builtin_ctzll(w);
-                    mirror::Object obj(ptr_base + shift * kObjectAlignment, heap_begin_ref);
-                    if (obj.IsNonLargeValid()) {
-                        visitor(obj);
-                    } else if (check) {
-                        LOGE("0x%lx is bad object on [0x%lx, 0x%lx).\n", obj.Ptr(), visit_begin, visit_end);
-                    }
-                    w ^= (static_cast<uint64_t>(1)) << shift;
-                } while (w != 0);
+        uint64_t i = index_start + 1;
+        while (i < index_end) {
+            if (words) {
+                // Sparse bitmaps are mostly zero, jump over empty 256-bit strides.
+                uint64_t skip = SkipZeroWords(words + (i - index_start) * point_bit,
+                                              (index_end - i) * point_bit);
+                i += skip / point_bit;
+                if (i >= index_end)
+                    break;
             }
+            uint64_t w = word_of(i);
+            if (w != 0)
+                visit_word(i, w);
+            ++i;
         }
 
         // Right edge is unique.
@@ -140,7 +236,7 @@ void ContinuousSpaceBitmap::VisitMarkedRange(uint64_t visit_begin, uint64_t visi
             // Do not read memory, as it could be after the end of the bitmap.
             right_edge = 0;
         } else {
-            right_edge = bitmap_begin_ref.valueOf((index_end * point_bit));
+            right_edge = word_of(index_end);
         }
     } else {
         // Right edge = left edge.
@@ -149,20 +245,8 @@ void ContinuousSpaceBitmap::VisitMarkedRange(uint64_t visit_begin, uint64_t visi
 
     // Right edge handling.
     right_edge &= ((static_cast<uint64_t>(1) << bit_end) - 1);
-    if (right_edge != 0) {
-        uint64_t ptr_base = IndexToOffset(index_end, point_bit) + heap_begin_ref.Ptr();
-        // Iterate on the bits set in word `right_edge`, from the least to the most significant bit.
-        do {
-            uint64_t shift = __builtin_ctzll(right_edge);
-            mirror::Object obj(ptr_base + shift * kObjectAlignment, heap_begin_ref);
-            if (obj.IsNonLargeValid()) {
-                visitor(obj);
-            } else if (check) {
-                LOGE("0x%lx is bad object on [0x%lx, 0x%lx).\n", obj.Ptr(), visit_begin, visit_end);
-            }
-            right_edge ^= (static_cast<uint64_t>(1)) << shift;
-        } while (right_edge != 0);
-    }
+    if (right_edge != 0)
+        visit_word(index_end, right_edge);
 }
 
 uint64_t ContinuousSpaceBitmap::OffsetToIndex(uint64_t offset, int point_bit) {
@@ -25,6 +25,12 @@
 #include "runtime/gc/space/large_object_space.h"
 #include "runtime/gc/space/fake_space.h"
 #include "runtime/gc/space/bump_pointer_space.h"
+#include "runtime/runtime.h"
+#include "runtime/runtime_globals.h"
+#include "runtime/thread.h"
+#include "runtime/thread_list.h"
+#include <mutex>
+#include <algorithm>
 
 struct Heap_OffsetTable __Heap_offset__;
 struct Heap_SizeTable __Heap_size__;
@@ -188,5 +194,61 @@ space::ContinuousSpace* Heap::FindContinuousSpaceFromObject(mirror::Object& obje
     return nullptr;
 }
 
+HeapGraph& Heap::GetHeapGraph() {
+    if (!heap_graph_second_cache) {
+        heap_graph_second_cache = std::make_unique<HeapGraph>();
+        heap_graph_second_cache->Build();
+    }
+    return *heap_graph_second_cache;
+}
+
+HeapRoots& Heap::GetHeapRoots() {
+    if (!heap_roots_second_cache) {
+        heap_roots_second_cache = std::make_unique<HeapRoots>();
+        heap_roots_second_cache->Build();
+    }
+    return *heap_roots_second_cache;
+}
+
+HeapDominator& Heap::GetHeapDominator() {
+    if (!heap_dominator_second_cache) {
+        heap_dominator_second_cache = std::make_unique<HeapDominator>();
+        heap_dominator_second_cache->Build(GetHeapGraph(), GetHeapRoots());
+    }
+    return *heap_dominator_second_cache;
+}
+
+mirror::ClassInfoCache& Heap::GetClassInfoCache() {
+    // may be first touched by parallel walkers.
+    std::call_once(*class_info_once, [&] {
+        class_info_second_cache = std::make_unique<mirror::ClassInfoCache>();
+    });
+    return *class_info_second_cache;
+}
+
+std::vector<std::pair<uint64_t, uint64_t>>& Heap::GetUnusedTlabs() {
+    // may be first touched by parallel walkers.
+    std::call_once(*unused_tlabs_once, [&] {
+        unused_tlabs_second_cache = std::make_unique<std::vector<std::pair<uint64_t, uint64_t>>>();
+        std::vector<std::pair<uint64_t, uint64_t>>& tlabs = *unused_tlabs_second_cache;
+        for (const auto& thread : Runtime::Current().GetThreadList().GetList()) {
+            try {
+                Thread::tls_ptr_sized_values& tls = thread->GetTlsPtr();
+                uint64_t start = tls.thread_local_start();
+                uint64_t pos = tls.thread_local_pos();
+                uint64_t end = tls.thread_local_end();
+                // no TLAB, or a layout we don't understand.
+                if (!start || start > pos || pos >= end || pos % kObjectAlignment)
+                    continue;
+                tlabs.push_back({pos, end});
+            } catch(InvalidAddressException e) {
+                LOGD("Thread(%d) tlab read fail.\n", thread->GetTid());
+            }
+        }
+        std::sort(tlabs.begin(), tlabs.end());
+    });
+    return *unused_tlabs_second_cache;
+}
+
 } // namespace gc
 } // namespace art
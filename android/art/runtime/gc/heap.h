@@ -21,8 +21,14 @@
 #include "api/memory_ref.h"
 #include "cxx/vector.h"
 #include "runtime/gc/space/space.h"
+#include "runtime/gc/heap_graph.h"
+#include "runtime/gc/heap_roots.h"
+#include "runtime/gc/heap_dominator.h"
+#include "runtime/mirror/class_info.h"
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 struct Heap_OffsetTable {
     uint32_t continuous_spaces_;
@@ -60,9 +66,22 @@ public:
     cxx::vector& GetDiscontinuousSpacesCache();
     std::vector<std::unique_ptr<space::ContinuousSpace>>& GetContinuousSpaces();
     std::vector<std::unique_ptr<space::DiscontinuousSpace>>& GetDiscontinuousSpaces();
+    HeapGraph& GetHeapGraph();
+    HeapRoots& GetHeapRoots();
+    HeapDominator& GetHeapDominator();
+    mirror::ClassInfoCache& GetClassInfoCache();
+    // [thread_local_pos, thread_local_end) of every thread TLAB, sorted.
+    std::vector<std::pair<uint64_t, uint64_t>>& GetUnusedTlabs();
     void CleanCache() {
         continuous_spaces_second_cache.clear();
         discontinuous_spaces_second_cache.clear();
+        heap_graph_second_cache.reset();
+        heap_roots_second_cache.reset();
+        heap_dominator_second_cache.reset();
+        class_info_second_cache.reset();
+        unused_tlabs_second_cache.reset();
+        class_info_once = std::make_unique<std::once_flag>();
+        unused_tlabs_once = std::make_unique<std::once_flag>();
     }
 
     space::ContinuousSpace* FindContinuousSpaceFromObject(mirror::Object& object);
@@ -74,6 +93,14 @@ private:
     // second cache
     std::vector<std::unique_ptr<space::ContinuousSpace>> continuous_spaces_second_cache;
     std::vector<std::unique_ptr<space::DiscontinuousSpace>> discontinuous_spaces_second_cache;
+    std::unique_ptr<HeapGraph> heap_graph_second_cache;
+    std::unique_ptr<HeapRoots> heap_roots_second_cache;
+    std::unique_ptr<HeapDominator> heap_dominator_second_cache;
+    std::unique_ptr<mirror::ClassInfoCache> class_info_second_cache;
+    std::unique_ptr<std::vector<std::pair<uint64_t, uint64_t>>> unused_tlabs_second_cache;
+    // built once, parallel walkers read them without locking afterwards.
+    std::unique_ptr<std::once_flag> class_info_once = std::make_unique<std::once_flag>();
+    std::unique_ptr<std::once_flag> unused_tlabs_once = std::make_unique<std::once_flag>();
 };
 
 } // namespace gc
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logger/log.h"
+#include "common/exception.h"
+#include "runtime/gc/heap_dominator.h"
+#include "runtime/mirror/object.h"
+#include "runtime/mirror/class.h"
+#include <algorithm>
+#include <tuple>
+
+namespace art {
+namespace gc {
+
+void HeapDominator::Build(HeapGraph& graph, HeapRoots& roots) {
+    graph_ = &graph;
+    uint32_t num = graph.NumberOfObjects();
+    root_ = num;
+
+    // successors of the virtual root
+    std::vector<uint32_t> root_nodes;
+    std::vector<bool> is_root(num, false);
+    for (const auto& root : roots.GetRoots()) {
+        if (!HeapRoots::IsStrong(root.type))
+            continue;
+        uint32_t idx = graph.IndexOf(root.ref);
+        if (idx == kInvalidIndex || is_root[idx])
+            continue;
+        is_root[idx] = true;
+        root_nodes.push_back(idx);
+    }
+
+    // depth first numbering, everything below is indexed by dfn.
+    std::vector<uint32_t> dfn(num + 1, kInvalidIndex);
+    std::vector<uint32_t> vertex;
+    std::vector<uint32_t> parent;
+    auto visit = [&](uint32_t v, uint32_t p) {
+        dfn[v] = vertex.size();
+        vertex.push_back(v);
+        parent.push_back(p);
+    };
+    // node, next successor, referent to skip
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> walk;
+    visit(root_, kInvalidIndex);
+    walk.emplace_back(root_, 0, kInvalidIndex);
+    while (!walk.empty()) {
+        auto& top = walk.back();
+        uint32_t v = std::get<0>(top);
+        uint32_t count = v == root_ ? root_nodes.size() : graph.NumberOfRefs(v);
+        if (std::get<1>(top) >= count) {
+            walk.pop_back();
+            continue;
+        }
+        uint32_t t = v == root_ ? root_nodes[std::get<1>(top)] : graph.Refs(v)[std::get<1>(top)];
+        std::get<1>(top)++;
+        if (t == std::get<2>(top) || dfn[t] != kInvalidIndex)
+            continue;
+        visit(t, dfn[v]);
+        walk.emplace_back(t, 0, graph.ReferentOf(t));
+    }
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>().swap(walk);
+
+    uint32_t count = vertex.size();
+    std::vector<uint32_t> semi(count);
+    std::vector<uint32_t> label(count);
+    std::vector<uint32_t> ancestor(count, kInvalidIndex);
+    std::vector<uint32_t> idom(count, 0);
+    std::vector<uint32_t> bucket(count, kInvalidIndex);
+    std::vector<uint32_t> bucket_next(count, kInvalidIndex);
+    for (uint32_t i = 0; i < count; ++i) {
+        semi[i] = i;
+        label[i] = i;
+    }
+
+    std::vector<uint32_t> path;
+    auto eval = [&](uint32_t v) -> uint32_t {
+        if (ancestor[v] == kInvalidIndex)
+            return v;
+        // path compression, from the forest root down to v.
+        path.clear();
+        uint32_t x = v;
+        while (ancestor[ancestor[x]] != kInvalidIndex) {
+            path.push_back(x);
+            x = ancestor[x];
+        }
+        while (!path.empty()) {
+            uint32_t y = path.back();
+            path.pop_back();
+            uint32_t a = ancestor[y];
+            if (semi[label[a]] < semi[label[y]])
+                label[y] = label[a];
+            ancestor[y] = ancestor[a];
+        }
+        return label[v];
+    };
+
+    for (uint32_t i = count - 1; i > 0; --i) {
+        uint32_t w = vertex[i];
+        if (is_root[w])
+            semi[i] = 0;
+        uint32_t* referrers = graph.Referrers(w);
+        uint32_t referrer_count = graph.NumberOfReferrers(w);
+        for (uint32_t k = 0; k < referrer_count; ++k) {
+            uint32_t u = referrers[k];
+            if (dfn[u] == kInvalidIndex || graph.IsWeakEdge(u, w))
+                continue;
+            uint32_t x = eval(dfn[u]);
+            if (semi[x] < semi[i])
+                semi[i] = semi[x];
+        }
+        bucket_next[i] = bucket[semi[i]];
+        bucket[semi[i]] = i;
+
+        uint32_t p = parent[i];
+        ancestor[i] = p;
+        for (uint32_t v = bucket[p]; v != kInvalidIndex; v = bucket_next[v]) {
+            uint32_t x = eval(v);
+            idom[v] = semi[x] < semi[v] ? x : p;
+        }
+        bucket[p] = kInvalidIndex;
+    }
+    for (uint32_t i = 1; i < count; ++i) {
+        if (idom[i] != semi[i])
+            idom[i] = idom[idom[i]];
+    }
+    std::vector<uint32_t>().swap(semi);
+    std::vector<uint32_t>().swap(label);
+    std::vector<uint32_t>().swap(ancestor);
+    std::vector<uint32_t>().swap(bucket);
+    std::vector<uint32_t>().swap(bucket_next);
+
+    // a dominator always has a smaller dfn, sum up in reverse order.
+    std::vector<uint64_t> retained(count, 0);
+    for (uint32_t i = 1; i < count; ++i)
+        retained[i] = graph.SizeOf(vertex[i]);
+    for (uint32_t i = count - 1; i > 0; --i)
+        retained[idom[i]] += retained[i];
+
+    idom_.assign(num + 1, kInvalidIndex);
+    retained_.assign(num + 1, 0);
+    child_offsets_.assign(num + 2, 0);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t v = vertex[i];
+        retained_[v] = retained[i];
+        if (i) {
+            idom_[v] = vertex[idom[i]];
+            child_offsets_[idom_[v] + 1]++;
+        }
+    }
+    for (uint32_t i = 0; i <= num; ++i)
+        child_offsets_[i + 1] += child_offsets_[i];
+    children_.resize(count ? count - 1 : 0);
+    std::vector<uint32_t> cursor(child_offsets_.begin(), child_offsets_.end() - 1);
+    for (uint32_t i = 1; i < count; ++i) {
+        uint32_t v = vertex[i];
+        children_[cursor[idom_[v]]++] = v;
+    }
+    for (uint32_t i = 0; i <= num; ++i) {
+        std::sort(Dominated(i), Dominated(i) + NumberOfDominated(i), [&](uint32_t a, uint32_t b) {
+            return retained_[a] > retained_[b];
+        });
+    }
+
+    reachable_ = count - 1;
+    class_retained_.clear();
+    LOGD("Heap dominator reachable(%ld) retained(%ld)\n", reachable_, retained_[root_]);
+}
+
+std::unordered_map<uint32_t, uint64_t>& HeapDominator::GetClassRetainedSizes() {
+    if (!class_retained_.empty() || !graph_)
+        return class_retained_;
+
+    std::unordered_map<uint32_t, uint32_t> active;
+    // node, next child, class
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> walk;
+    walk.emplace_back(root_, 0, 0);
+    while (!walk.empty()) {
+        auto& top = walk.back();
+        uint32_t v = std::get<0>(top);
+        if (std::get<1>(top) >= NumberOfDominated(v)) {
+            uint32_t klass = std::get<2>(top);
+            if (klass) active[klass]--;
+            walk.pop_back();
+            continue;
+        }
+        uint32_t child = Dominated(v)[std::get<1>(top)];
+        std::get<1>(top)++;
+
+        uint32_t klass = 0;
+        try {
+            mirror::Object object(graph_->AddressOf(child));
+            klass = object.GetClass().Ptr();
+        } catch(InvalidAddressException e) {
+            // not counted
+        }
+        if (klass && !active[klass]++)
+            class_retained_[klass] += retained_[child];
+        walk.emplace_back(child, 0, klass);
+    }
+    return class_retained_;
+}
+
+} // namespace gc
+} // namespace art
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_ART_RUNTIME_GC_HEAP_DOMINATOR_H_
+#define ANDROID_ART_RUNTIME_GC_HEAP_DOMINATOR_H_
+
+#include "runtime/gc/heap_graph.h"
+#include "runtime/gc/heap_roots.h"
+#include <stdint.h>
+#include <sys/types.h>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace art {
+namespace gc {
+
+/*
+ * Dominator tree of the heap graph (Lengauer-Tarjan), rooted at a virtual
+ * node whose successors are the strong GC roots. Referent edges of
+ * java.lang.ref.Reference objects are not followed.
+ *
+ * idom_ and retained_ are indexed by graph node, objects not reachable
+ * from any root have no dominator and retain nothing.
+ */
+class HeapDominator {
+public:
+    static constexpr uint32_t kInvalidIndex = HeapGraph::kInvalidIndex;
+
+    HeapDominator() {}
+    ~HeapDominator() {}
+
+    void Build(HeapGraph& graph, HeapRoots& roots);
+    // the virtual root, dominator of every object directly held by a gc root.
+    inline uint32_t Root() { return root_; }
+    inline bool IsReachable(uint32_t idx) { return idx == root_ || idom_[idx] != kInvalidIndex; }
+    inline uint32_t ImmediateDominator(uint32_t idx) { return idom_[idx]; }
+    inline uint64_t RetainedSize(uint32_t idx) { return retained_[idx]; }
+    inline uint64_t NumberOfReachable() { return reachable_; }
+
+    inline uint32_t NumberOfDominated(uint32_t idx) { return child_offsets_[idx + 1] - child_offsets_[idx]; }
+    inline uint32_t* Dominated(uint32_t idx) { return children_.data() + child_offsets_[idx]; }
+
+    /*
+     * Retained size of all instances of each class together, an instance
+     * dominated by another instance of the same class is not counted twice.
+     */
+    std::unordered_map<uint32_t, uint64_t>& GetClassRetainedSizes();
+private:
+    uint32_t root_ = kInvalidIndex;
+    uint64_t reachable_ = 0;
+    std::vector<uint32_t> idom_;
+    std::vector<uint64_t> retained_;
+    std::vector<uint32_t> child_offsets_;
+    std::vector<uint32_t> children_;
+    HeapGraph* graph_ = nullptr;
+    std::unordered_map<uint32_t, uint64_t> class_retained_;
+};
+
+} // namespace gc
+} // namespace art
+
+#endif // ANDROID_ART_RUNTIME_GC_HEAP_DOMINATOR_H_
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logger/log.h"
+#include "android.h"
+#include "common/exception.h"
+#include "runtime/gc/heap_graph.h"
+#include "runtime/runtime.h"
+#include "runtime/mirror/class.h"
+#include "runtime/mirror/array.h"
+#include "runtime/art_field.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace art {
+namespace gc {
+
+class GraphPartition {
+public:
+    std::vector<uint32_t> objects;
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> sizes;
+    std::vector<uint32_t> refs;
+    std::vector<std::pair<uint32_t, uint32_t>> referents;
+};
+
+const mirror::ClassInfo& HeapGraph::VisitReferences(mirror::ClassInfoCache& cache, mirror::Object& object, std::function<void (uint32_t ref)> fn) {
+    const mirror::ClassInfo& info = cache.GetClassInfoOf(object);
+    info.ForeachReferenceOffset([&](uint32_t offset) {
+        fn(object.value32Of(offset));
+    });
+
+    if (info.IsObjectArray()) {
+        mirror::Array array = object;
+        uint32_t length = array.GetLength();
+        if (!length) return info;
+        api::MemoryRef ref(array.GetRawData(sizeof(uint32_t), 0), array);
+        uint32_t* data = reinterpret_cast<uint32_t*>(ref.Real());
+        LoadBlock* block = ref.Block();
+        uint64_t end = ref.Ptr() + static_cast<uint64_t>(length) * sizeof(uint32_t);
+        if (!block->virtualContains(end - 1)) {
+            // corrupt length, only the elements inside the block are readable.
+            uint64_t avail = block->vaddr() + block->size() - (ref.Ptr() & block->VabitsMask());
+            length = avail / sizeof(uint32_t);
+        }
+        for (uint32_t i = 0; i < length; ++i) {
+            fn(data[i]);
+        }
+    } else if (info.IsClass()) {
+        mirror::Class thiz = object;
+        if (!thiz.IsResolved())
+            return info;
+        auto callback = [&](ArtField& field) -> bool {
+            const char* type = field.GetTypeDescriptor();
+            if (type[0] == 'L' || type[0] == '[')
+                fn(field.GetObj(object));
+            return false;
+        };
+        Android::ForeachStaticField(thiz, callback);
+    }
+    return info;
+}
+
+void HeapGraph::Build() {
+    // staging, unsorted in walk order
+    std::vector<uint32_t> addrs;
+    std::vector<uint64_t> begins;
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> sizes;
+    std::vector<uint32_t> raws;
+    std::vector<std::pair<uint32_t, uint32_t>> referents;
+
+    mirror::ClassInfoCache& cache = Runtime::Current().GetHeap().GetClassInfoCache();
+    auto callback = [&](GraphPartition& partition, mirror::Object& object) -> bool {
+        uint32_t count = 0;
+        auto visitor = [&](uint32_t ref) {
+            if (!ref) return;
+            partition.refs.push_back(ref);
+            count++;
+        };
+        uint32_t size = 0;
+        try {
+            const mirror::ClassInfo& info = VisitReferences(cache, object, visitor);
+            if (info.IsReference()) {
+                uint32_t referent = object.value32Of(info.referent_offset);
+                if (referent)
+                    partition.referents.push_back(std::make_pair(object.Ptr(), referent));
+            }
+            size = info.SizeOf(object);
+        } catch(InvalidAddressException e) {
+            // keep visited references
+        }
+        partition.objects.push_back(object.Ptr());
+        partition.counts.push_back(count);
+        partition.sizes.push_back(size);
+        return false;
+    };
+    auto merge = [&](GraphPartition& partition) {
+        uint64_t begin = raws.size();
+        for (uint32_t i = 0; i < partition.objects.size(); ++i) {
+            addrs.push_back(partition.objects[i]);
+            begins.push_back(begin);
+            counts.push_back(partition.counts[i]);
+            sizes.push_back(partition.sizes[i]);
+            begin += partition.counts[i];
+        }
+        raws.insert(raws.end(), partition.refs.begin(), partition.refs.end());
+        referents.insert(referents.end(), partition.referents.begin(), partition.referents.end());
+    };
+    Android::ParallelForeachObjects<GraphPartition>(callback, merge,
+            Android::EACH_IMAGE_OBJECTS | Android::EACH_ZYGOTE_OBJECTS
+                    | Android::EACH_APP_OBJECTS | Android::EACH_FAKE_OBJECTS, false);
+
+    std::vector<uint32_t> order(addrs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return addrs[a] < addrs[b];
+    });
+
+    objects_.clear();
+    sizes_.clear();
+    std::vector<uint32_t> nodes;
+    for (const auto& pos : order) {
+        if (!objects_.empty() && objects_.back() == addrs[pos])
+            continue;
+        objects_.push_back(addrs[pos]);
+        sizes_.push_back(sizes[pos]);
+        nodes.push_back(pos);
+    }
+    std::vector<uint32_t>().swap(sizes);
+
+    referents_.clear();
+    for (const auto& value : referents) {
+        uint32_t node = IndexOf(value.first);
+        uint32_t referent = IndexOf(value.second);
+        if (node != kInvalidIndex && referent != kInvalidIndex)
+            referents_.push_back(std::make_pair(node, referent));
+    }
+    std::sort(referents_.begin(), referents_.end());
+
+    uint32_t num = objects_.size();
+    out_offsets_.assign(num + 1, 0);
+    out_edges_.clear();
+    std::vector<uint32_t> targets;
+    for (uint32_t i = 0; i < num; ++i) {
+        uint32_t pos = nodes[i];
+        targets.clear();
+        for (uint32_t j = 0; j < counts[pos]; ++j) {
+            uint32_t target = IndexOf(raws[begins[pos] + j]);
+            if (target != kInvalidIndex)
+                targets.push_back(target);
+        }
+        std::sort(targets.begin(), targets.end());
+        targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+        out_edges_.insert(out_edges_.end(), targets.begin(), targets.end());
+        out_offsets_[i + 1] = out_edges_.size();
+    }
+    std::vector<uint32_t>().swap(raws);
+
+    in_offsets_.assign(num + 1, 0);
+    for (const auto& target : out_edges_) {
+        in_offsets_[target + 1]++;
+    }
+    for (uint32_t i = 0; i < num; ++i) {
+        in_offsets_[i + 1] += in_offsets_[i];
+    }
+    in_edges_.resize(out_edges_.size());
+    std::vector<uint64_t> cursor(in_offsets_.begin(), in_offsets_.end() - 1);
+    for (uint32_t i = 0; i < num; ++i) {
+        for (uint64_t k = out_offsets_[i]; k < out_offsets_[i + 1]; ++k) {
+            in_edges_[cursor[out_edges_[k]]++] = i;
+        }
+    }
+
+    LOGD("Heap graph objects(%d) references(%ld)\n", num, out_edges_.size());
+}
+
+uint32_t HeapGraph::IndexOf(uint64_t address) {
+    auto it = std::lower_bound(objects_.begin(), objects_.end(), address);
+    if (it == objects_.end() || *it != address)
+        return kInvalidIndex;
+    return it - objects_.begin();
+}
+
+uint32_t HeapGraph::ReferentOf(uint32_t idx) {
+    auto it = std::lower_bound(referents_.begin(), referents_.end(), std::make_pair(idx, 0u));
+    if (it == referents_.end() || it->first != idx)
+        return kInvalidIndex;
+    return it->second;
+}
+
+bool HeapGraph::ShortestPathToRoot(HeapRoots& roots, uint32_t target, std::vector<uint32_t>& path) {
+    path.clear();
+    if (target >= NumberOfObjects())
+        return false;
+
+    auto is_root = [&](uint32_t idx) -> bool {
+        return roots.IsRoot(AddressOf(idx));
+    };
+    if (is_root(target)) {
+        path.push_back(target);
+        return true;
+    }
+
+    // backward side: node -> {next node toward target, depth from target}
+    // forward side : node -> {previous node toward root (kInvalidIndex for roots), depth from root}
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> backward;
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> forward;
+    std::vector<uint32_t> backward_frontier;
+    std::vector<uint32_t> forward_frontier;
+    std::vector<uint32_t> next;
+
+    backward[target] = {kInvalidIndex, 0};
+    backward_frontier.push_back(target);
+    for (const auto& root : roots.GetRoots()) {
+        if (!HeapRoots::IsStrong(root.type))
+            continue;
+        uint32_t idx = IndexOf(root.ref);
+        if (idx != kInvalidIndex && forward.emplace(idx, std::make_pair(kInvalidIndex, 0)).second)
+            forward_frontier.push_back(idx);
+    }
+
+    // a level can meet the other side at several depths, keep the shortest sum.
+    uint32_t meet = kInvalidIndex;
+    uint32_t best = UINT32_MAX;
+    auto try_meet = [&](uint32_t idx) {
+        auto fit = forward.find(idx);
+        auto bit = backward.find(idx);
+        if (fit == forward.end() || bit == backward.end())
+            return;
+        uint32_t length = fit->second.second + bit->second.second;
+        if (length < best) {
+            best = length;
+            meet = idx;
+        }
+    };
+
+    while (meet == kInvalidIndex && !backward_frontier.empty() && !forward_frontier.empty()) {
+        next.clear();
+        if (backward_frontier.size() <= forward_frontier.size()) {
+            for (const auto& w : backward_frontier) {
+                uint32_t depth = backward[w].second + 1;
+                uint32_t* referrers = Referrers(w);
+                uint32_t count = NumberOfReferrers(w);
+                for (uint32_t i = 0; i < count; ++i) {
+                    uint32_t u = referrers[i];
+                    if (IsWeakEdge(u, w) || !backward.emplace(u, std::make_pair(w, depth)).second)
+                        continue;
+                    try_meet(u);
+                    next.push_back(u);
+                }
+            }
+            backward_frontier.swap(next);
+        } else {
+            for (const auto& v : forward_frontier) {
+                uint32_t depth = forward[v].second + 1;
+                uint32_t* refs = Refs(v);
+                uint32_t count = NumberOfRefs(v);
+                uint32_t referent = referents_.empty() ? kInvalidIndex : ReferentOf(v);
+                for (uint32_t i = 0; i < count; ++i) {
+                    uint32_t t = refs[i];
+                    if (t == referent || !forward.emplace(t, std::make_pair(v, depth)).second)
+                        continue;
+                    try_meet(t);
+                    next.push_back(t);
+                }
+            }
+            forward_frontier.swap(next);
+        }
+    }
+
+    if (meet == kInvalidIndex)
+        return false;
+
+    for (uint32_t idx = meet; idx != kInvalidIndex; idx = forward[idx].first)
+        path.push_back(idx);
+    std::reverse(path.begin(), path.end());
+    for (uint32_t idx = backward[meet].first; idx != kInvalidIndex; idx = backward[idx].first)
+        path.push_back(idx);
+    return true;
+}
+
+void HeapGraph::ForeachReferrer(mirror::Object& object, std::function<bool (mirror::Object& referrer)> fn) {
+    uint32_t idx = IndexOf(object.Ptr());
+    if (idx == kInvalidIndex)
+        return;
+
+    uint32_t* referrers = Referrers(idx);
+    uint32_t count = NumberOfReferrers(idx);
+    for (uint32_t i = 0; i < count; ++i) {
+        mirror::Object referrer = AddressOf(referrers[i]);
+        if (fn(referrer)) break;
+    }
+}
+
+void HeapGraph::ForeachReference(mirror::Object& object, std::function<bool (mirror::Object& reference)> fn) {
+    uint32_t idx = IndexOf(object.Ptr());
+    if (idx == kInvalidIndex)
+        return;
+
+    uint32_t* refs = Refs(idx);
+    uint32_t count = NumberOfRefs(idx);
+    for (uint32_t i = 0; i < count; ++i) {
+        mirror::Object reference = AddressOf(refs[i]);
+        if (fn(reference)) break;
+    }
+}
+
+} // namespace gc
+} // namespace art
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_ART_RUNTIME_GC_HEAP_GRAPH_H_
+#define ANDROID_ART_RUNTIME_GC_HEAP_GRAPH_H_
+
+#include "runtime/mirror/object.h"
+#include "runtime/mirror/class_info.h"
+#include "runtime/gc/heap_roots.h"
+#include <stdint.h>
+#include <sys/types.h>
+#include <functional>
+#include <vector>
+#include <utility>
+
+namespace art {
+namespace gc {
+
+/*
+ * Object reference graph of the whole heap, built once by walking every
+ * object and reading reference slots from its class layout (instance fields,
+ * static fields of classes, object array elements).
+ *
+ * objects_ is sorted by address, node index is the position in objects_,
+ * both directions are kept as CSR:
+ *   refs of node i     : out_edges_[out_offsets_[i] ... out_offsets_[i + 1])
+ *   referrers of node i: in_edges_[in_offsets_[i] ... in_offsets_[i + 1])
+ *
+ * referent of every java.lang.ref.Reference is kept aside in referents_,
+ * so reachability walkers can tell the weak edge from the strong ones.
+ */
+class HeapGraph {
+public:
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFF;
+
+    HeapGraph() {}
+    ~HeapGraph() {}
+
+    void Build();
+    inline uint32_t NumberOfObjects() { return objects_.size(); }
+    inline uint64_t NumberOfReferences() { return out_edges_.size(); }
+    inline uint64_t AddressOf(uint32_t idx) { return objects_[idx]; }
+    uint32_t IndexOf(uint64_t address);
+
+    inline uint32_t NumberOfReferrers(uint32_t idx) { return in_offsets_[idx + 1] - in_offsets_[idx]; }
+    inline uint32_t* Referrers(uint32_t idx) { return in_edges_.data() + in_offsets_[idx]; }
+    inline uint32_t NumberOfRefs(uint32_t idx) { return out_offsets_[idx + 1] - out_offsets_[idx]; }
+    inline uint32_t* Refs(uint32_t idx) { return out_edges_.data() + out_offsets_[idx]; }
+    inline uint64_t SizeOf(uint32_t idx) { return sizes_[idx]; }
+
+    // node index of the referent if node idx is a Reference, kInvalidIndex otherwise.
+    uint32_t ReferentOf(uint32_t idx);
+    inline bool IsWeakEdge(uint32_t from, uint32_t to) {
+        return !referents_.empty() && ReferentOf(from) == to;
+    }
+
+    /*
+     * Shortest chain of strong references from any strong gc root to target,
+     * bidirectional BFS (referrers of target, references of roots), the
+     * smaller frontier is expanded first. path[0] is the root object and
+     * path.back() the target, false if target is not reachable.
+     */
+    bool ShortestPathToRoot(HeapRoots& roots, uint32_t target, std::vector<uint32_t>& path);
+
+    void ForeachReferrer(mirror::Object& object, std::function<bool (mirror::Object& referrer)> fn);
+    void ForeachReference(mirror::Object& object, std::function<bool (mirror::Object& reference)> fn);
+
+    /*
+     * Layout-based reference visitor, klass_ is visited as the first slot.
+     * Layout of classes comes from the shared class info cache.
+     */
+    static const mirror::ClassInfo& VisitReferences(mirror::ClassInfoCache& cache, mirror::Object& object, std::function<void (uint32_t ref)> fn);
+private:
+    std::vector<uint32_t> objects_;
+    std::vector<uint32_t> sizes_;
+    // (node, referent node), sorted by node.
+    std::vector<std::pair<uint32_t, uint32_t>> referents_;
+    std::vector<uint64_t> out_offsets_;
+    std::vector<uint32_t> out_edges_;
+    std::vector<uint64_t> in_offsets_;
+    std::vector<uint32_t> in_edges_;
+};
+
+} // namespace gc
+} // namespace art
+
+#endif // ANDROID_ART_RUNTIME_GC_HEAP_GRAPH_H_
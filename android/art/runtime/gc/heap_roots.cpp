@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logger/log.h"
+#include "android.h"
+#include "common/exception.h"
+#include "runtime/gc/heap_roots.h"
+#include "runtime/runtime.h"
+#include "runtime/class_linker.h"
+#include "runtime/thread.h"
+#include "runtime/thread_list.h"
+#include "runtime/stack.h"
+#include "runtime/java_frame.h"
+#include "runtime/jni/java_vm_ext.h"
+#include "runtime/jni/jni_env_ext.h"
+#include "runtime/mirror/class.h"
+#include "base/thread_pool.h"
+#include <algorithm>
+
+namespace art {
+namespace gc {
+
+class ClassPartition {
+public:
+    std::vector<uint32_t> classes;
+};
+
+void HeapRoots::VisitThreadRoots(Thread* thread, std::vector<Root>& roots) {
+    uint32_t thread_id = thread->GetThreadId();
+    Thread::tls_ptr_sized_values& tls = thread->GetTlsPtr();
+
+    mirror::Object peer = tls.opeer();
+    if (peer.Ptr() && peer.IsValid())
+        roots.push_back({static_cast<uint32_t>(peer.Ptr()), kRootThreadObject, thread_id, kInvalidIndex});
+
+    if (JNIEnvExt::HasIndirectLocals() && tls.jni_env()) {
+        try {
+            JNIEnvExt env(tls.jni_env(), tls);
+            IndirectReferenceTable& locals = env.GetLocalsTable();
+            auto callback = [&](mirror::Object& object, uint64_t /*idx*/) -> bool {
+                roots.push_back({static_cast<uint32_t>(object.Ptr()), kRootJNILocal, thread_id, kInvalidIndex});
+                return false;
+            };
+            locals.Walk(callback);
+        } catch(InvalidAddressException e) {
+            LOGD("Thread(%d) jni locals walk fail.\n", thread_id);
+        }
+    }
+
+    StackVisitor visitor(thread, StackVisitor::StackWalkKind::kSkipInlinedFrames);
+    visitor.WalkStack();
+    uint32_t depth = 0;
+    for (const auto& java_frame : visitor.GetJavaFrames()) {
+        auto callback = [&](uint32_t ref) {
+            mirror::Object object(ref);
+            if (object.IsValid())
+                roots.push_back({ref, kRootJavaFrame, thread_id, depth});
+        };
+        try {
+            java_frame->VisitReferences(callback);
+        } catch(InvalidAddressException e) {
+            // keep visited references
+        }
+        depth++;
+    }
+}
+
+void HeapRoots::Build() {
+    roots_.clear();
+    Runtime& runtime = Runtime::Current();
+
+    JavaVMExt& jvm = runtime.GetJavaVM();
+    auto global_callback = [&](mirror::Object& object, uint64_t idx) -> bool {
+        roots_.push_back({static_cast<uint32_t>(object.Ptr()), kRootJNIGlobal, 0, static_cast<uint32_t>(idx)});
+        return false;
+    };
+    auto weak_global_callback = [&](mirror::Object& object, uint64_t idx) -> bool {
+        roots_.push_back({static_cast<uint32_t>(object.Ptr()), kRootJNIWeakGlobal, 0, static_cast<uint32_t>(idx)});
+        return false;
+    };
+    try {
+        jvm.GetGlobalsTable().Walk(global_callback);
+    } catch(InvalidAddressException e) {
+        LOGW("Walk global references table fail.\n");
+    }
+    try {
+        jvm.GetWeakGlobalsTable().Walk(weak_global_callback);
+    } catch(InvalidAddressException e) {
+        LOGW("Walk weak global references table fail.\n");
+    }
+
+    // one task per thread, stacks are independent of each other.
+    std::vector<Thread*> threads;
+    for (const auto& thread : runtime.GetThreadList().GetList())
+        threads.push_back(thread.get());
+    std::vector<std::vector<Root>> thread_roots(threads.size());
+    auto task = [&](uint32_t idx) {
+        try {
+            VisitThreadRoots(threads[idx], thread_roots[idx]);
+        } catch(InvalidAddressException e) {
+            // keep visited roots
+        }
+    };
+    auto done = [&](uint32_t idx) {
+        roots_.insert(roots_.end(), thread_roots[idx].begin(), thread_roots[idx].end());
+        std::vector<Root>().swap(thread_roots[idx]);
+    };
+    // shared caches must be ready before workers walk stacks.
+    StackVisitor::PrepareParallelWalk();
+    ThreadPool::ForEach(threads.size(), task, done);
+
+    // class linker keeps every loaded class alive, report them all as sticky.
+    std::vector<uint32_t> classes;
+    try {
+        classes = runtime.GetClassLinker().GetClasses();
+    } catch(InvalidAddressException e) {
+        LOGD("Walk class tables fail.\n");
+    }
+    for (const auto& klass : classes)
+        roots_.push_back({klass, kRootStickyClass, 0, kInvalidIndex});
+
+    // class tables not decoded, fall back to a heap walk.
+    auto class_callback = [&](ClassPartition& partition, mirror::Object& object) -> bool {
+        if (object.IsClass()) {
+            mirror::Class thiz = object;
+            if (!thiz.IsRetired())
+                partition.classes.push_back(object.Ptr());
+        }
+        return false;
+    };
+    auto class_merge = [&](ClassPartition& partition) {
+        for (const auto& klass : partition.classes)
+            roots_.push_back({klass, kRootStickyClass, 0, kInvalidIndex});
+    };
+    if (!classes.size()) {
+        Android::ParallelForeachObjects<ClassPartition>(class_callback, class_merge,
+                Android::EACH_IMAGE_OBJECTS | Android::EACH_ZYGOTE_OBJECTS
+                        | Android::EACH_APP_OBJECTS, false);
+    }
+
+    std::stable_sort(roots_.begin(), roots_.end(), [](const Root& a, const Root& b) {
+        return a.ref < b.ref;
+    });
+    LOGD("Heap roots %ld, threads %ld\n", roots_.size(), threads.size());
+}
+
+bool HeapRoots::IsRoot(uint64_t address) {
+    bool found = false;
+    mirror::Object object(static_cast<uint32_t>(address));
+    ForeachRoot(object, [&](Root& root) -> bool {
+        found = IsStrong(root.type);
+        return found;
+    });
+    return found;
+}
+
+void HeapRoots::ForeachRoot(mirror::Object& object, std::function<bool (Root& root)> fn) {
+    uint32_t ref = static_cast<uint32_t>(object.Ptr());
+    auto it = std::lower_bound(roots_.begin(), roots_.end(), ref, [](const Root& root, uint32_t value) {
+        return root.ref < value;
+    });
+    for (; it != roots_.end() && it->ref == ref; ++it) {
+        if (fn(*it))
+            break;
+    }
+}
+
+const char* HeapRoots::RootTypeName(uint32_t type) {
+    switch (type) {
+        case kRootJNIGlobal: return "JNI_GLOBAL";
+        case kRootJNILocal: return "JNI_LOCAL";
+        case kRootJavaFrame: return "JAVA_FRAME";
+        case kRootNativeStack: return "NATIVE_STACK";
+        case kRootStickyClass: return "STICKY_CLASS";
+        case kRootThreadBlock: return "THREAD_BLOCK";
+        case kRootMonitorUsed: return "MONITOR_USED";
+        case kRootThreadObject: return "THREAD_OBJECT";
+        case kRootInternedString: return "INTERNED_STRING";
+        case kRootFinalizing: return "FINALIZING";
+        case kRootDebugger: return "DEBUGGER";
+        case kRootReferenceCleanup: return "REFERENCE_CLEANUP";
+        case kRootVMInternal: return "VM_INTERNAL";
+        case kRootJNIMonitor: return "JNI_MONITOR";
+        case kRootJNIWeakGlobal: return "JNI_WEAK_GLOBAL";
+    }
+    return "UNKNOWN";
+}
+
+} // namespace gc
+} // namespace art
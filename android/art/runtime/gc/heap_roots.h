@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_ART_RUNTIME_GC_HEAP_ROOTS_H_
+#define ANDROID_ART_RUNTIME_GC_HEAP_ROOTS_H_
+
+#include "runtime/mirror/object.h"
+#include <stdint.h>
+#include <sys/types.h>
+#include <functional>
+#include <vector>
+
+namespace art {
+
+class Thread;
+
+namespace gc {
+
+enum RootType {
+    kRootUnknown = 0,
+    kRootJNIGlobal,
+    kRootJNILocal,
+    kRootJavaFrame,
+    kRootNativeStack,
+    kRootStickyClass,
+    kRootThreadBlock,
+    kRootMonitorUsed,
+    kRootThreadObject,
+    kRootInternedString,
+    kRootFinalizing,  // used for HPROF's conversion to HprofHeapTag
+    kRootDebugger,
+    kRootReferenceCleanup,  // used for HPROF's conversion to HprofHeapTag
+    kRootVMInternal,
+    kRootJNIMonitor,
+    // not a root for the runtime, kept for reachability queries only.
+    kRootJNIWeakGlobal,
+};
+
+/*
+ * GC roots of the whole runtime, enumerated once:
+ *   JNI globals and weak globals (JavaVMExt tables),
+ *   per thread: peer, JNI locals and references of java frames,
+ *   classes held by the class linker (every live class object).
+ *
+ * Threads are visited in parallel, roots_ is sorted by reference so the
+ * roots of one object are a contiguous range.
+ */
+class HeapRoots {
+public:
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFF;
+
+    class Root {
+    public:
+        uint32_t ref;
+        uint32_t type;
+        uint32_t thread_id;  // art thread id, 0 if not a thread root
+        uint32_t index;      // java frame depth, or jni reference index
+    };
+
+    HeapRoots() {}
+    ~HeapRoots() {}
+
+    void Build();
+    inline uint64_t NumberOfRoots() { return roots_.size(); }
+    inline std::vector<Root>& GetRoots() { return roots_; }
+
+    // strong roots only, weak globals never keep an object alive.
+    bool IsRoot(uint64_t address);
+    void ForeachRoot(mirror::Object& object, std::function<bool (Root& root)> fn);
+
+    static inline bool IsStrong(uint32_t type) { return type != kRootJNIWeakGlobal; }
+    static const char* RootTypeName(uint32_t type);
+private:
+    static void VisitThreadRoots(Thread* thread, std::vector<Root>& roots);
+
+    std::vector<Root> roots_;
+};
+
+} // namespace gc
+} // namespace art
+
+#endif // ANDROID_ART_RUNTIME_GC_HEAP_ROOTS_H_
@@ -19,6 +19,9 @@
 #include "runtime/gc/space/bump_pointer_space.h"
 #include "runtime/runtime_globals.h"
 #include "cxx/vector.h"
+#include "runtime/runtime.h"
+#include "runtime/gc/heap.h"
+#include <algorithm>
 
 struct BumpPointerSpace_OffsetTable __BumpPointerSpace_offset__;
 
@@ -88,8 +91,19 @@ void BumpPointerSpace::SlowWalk(std::function<bool (mirror::Object& object)> vis
     mirror::Object object_cache = pos;
     object_cache.Prepare(false);
 
+    // jump over unused tails of thread TLABs instead of probing them.
+    std::vector<std::pair<uint64_t, uint64_t>>& tlabs = Runtime::Current().GetHeap().GetUnusedTlabs();
+    auto tlab = std::upper_bound(tlabs.begin(), tlabs.end(), std::make_pair(pos, static_cast<uint64_t>(0)));
+    if (tlab != tlabs.begin() && std::prev(tlab)->second > pos) --tlab;
+
     // slow walk
     while (pos < end) {
+        while (tlab != tlabs.end() && tlab->second <= pos) ++tlab;
+        if (tlab != tlabs.end() && tlab->first <= pos) {
+            pos = tlab->second;
+            continue;
+        }
+
         mirror::Object object(pos, object_cache);
         if (object.IsValid()) {
             visitor(object);
@@ -100,6 +114,22 @@ void BumpPointerSpace::SlowWalk(std::function<bool (mirror::Object& object)> vis
     }
 }
 
+void BumpPointerSpace::WalkBlock(std::function<bool (mirror::Object& object)> visitor, uint64_t pos, uint64_t end, bool check) {
+    mirror::Object object_cache = pos;
+    object_cache.Prepare(false);
+
+    while (pos < end) {
+        mirror::Object object(pos, object_cache);
+        if (object.IsNonLargeValid()) {
+            visitor(object);
+            pos = GetNextObject(object);
+        } else {
+            pos = object.NextValidOffset(end);
+            if (check && pos < end) LOGE("Region:[0x%lx, 0x%lx) %s has bad object!!\n", object.Ptr(), pos, GetName());
+        }
+    }
+}
+
 void BumpPointerSpace::Walk(std::function<bool (mirror::Object& object)> visitor, bool check) {
     if (Android::Sdk() < Android::V) {
         SlowWalk(visitor);
@@ -108,10 +138,6 @@ void BumpPointerSpace::Walk(std::function<bool (mirror::Object& object)> visitor
 
     uint64_t pos = Begin();
     uint64_t end = End();
-    uint64_t main_end = pos;
-
-    mirror::Object object_cache = pos;
-    object_cache.Prepare(false);
 
     uint64_t main_block_size_tmp = main_block_size();
     std::deque<uint64_t>& block_sizes_ = GetBlockSizes();
@@ -119,43 +145,44 @@ void BumpPointerSpace::Walk(std::function<bool (mirror::Object& object)> visitor
         main_block_size_tmp = end - pos;
     }
 
-    main_end = Begin() + main_block_size_tmp;
-    if (!block_sizes_.size()) {
-        end = main_end;
-    } else {
-        // do nothing
+    uint64_t main_end = Begin() + main_block_size_tmp;
+    WalkBlock(visitor, pos, main_end, check);
+
+    pos = main_end;
+    for (const auto& block_size : block_sizes_) {
+        WalkBlock(visitor, pos, pos + block_size, check);
+        pos += block_size;
     }
+}
 
-    while (pos < main_end) {
-        mirror::Object object(pos, object_cache);
-        if (object.IsNonLargeValid()) {
-            visitor(object);
-            pos = GetNextObject(object);
-        } else {
-            pos = object.NextValidOffset(main_end);
-            if (check && pos < main_end) LOGE("Region:[0x%lx, 0x%lx) %s has bad object!!\n", object.Ptr(), pos, GetName());
-        }
+void BumpPointerSpace::Partition(std::vector<WalkPartition>& partitions, uint32_t split) {
+    if (split <= 1 || Android::Sdk() < Android::V) {
+        Space::Partition(partitions, split);
+        return;
     }
 
-    pos = main_end;
+    uint64_t pos = Begin();
+    uint64_t end = End();
 
-    if (block_sizes_.size()) {
-        for (const auto& block_size : block_sizes_) {
-            uint64_t cur_pos = pos;
-            uint64_t cur_end = pos + block_size;
-
-            while (cur_pos < cur_end) {
-                mirror::Object object(cur_pos, object_cache);
-                if (object.IsNonLargeValid()) {
-                    visitor(object);
-                    cur_pos = GetNextObject(object);
-                } else {
-                    cur_pos = object.NextValidOffset(cur_end);
-                    if (check && cur_pos < cur_end) LOGE("Region:[0x%lx, 0x%lx) %s has bad object!!\n", object.Ptr(), cur_pos, GetName());
-                }
-            }
-            pos += block_size;
-        }
+    // second cache must be ready before workers share it.
+    uint64_t main_block_size_tmp = main_block_size();
+    std::deque<uint64_t>& block_sizes_ = GetBlockSizes();
+    if (!block_sizes_.size()) {
+        main_block_size_tmp = end - pos;
+    }
+
+    uint64_t main_end = Begin() + main_block_size_tmp;
+    partitions.push_back([this, pos, main_end](std::function<bool (mirror::Object& object)> fn, bool check) {
+        WalkBlock(fn, pos, main_end, check);
+    });
+
+    pos = main_end;
+    for (const auto& block_size : block_sizes_) {
+        uint64_t cur_end = pos + block_size;
+        partitions.push_back([this, pos, cur_end](std::function<bool (mirror::Object& object)> fn, bool check) {
+            WalkBlock(fn, pos, cur_end, check);
+        });
+        pos = cur_end;
     }
 }
 
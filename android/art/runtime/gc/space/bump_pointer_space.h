@@ -52,6 +52,8 @@ public:
     SpaceType GetType() { return kSpaceTypeBumpPointerSpace; }
     void Walk(std::function<bool (mirror::Object& object)> fn, bool check);
     void SlowWalk(std::function<bool (mirror::Object& object)> fn);
+    void WalkBlock(std::function<bool (mirror::Object& object)> fn, uint64_t pos, uint64_t end, bool check);
+    void Partition(std::vector<WalkPartition>& partitions, uint32_t split);
 
     cxx::deque& GetBlockSizesCache();
     std::deque<uint64_t>& GetBlockSizes();
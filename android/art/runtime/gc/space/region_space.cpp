@@ -22,6 +22,9 @@
 #include "runtime/mirror/class.h"
 #include "runtime/mirror/object.h"
 #include "runtime/runtime_globals.h"
+#include "runtime/runtime.h"
+#include "runtime/gc/heap.h"
+#include <algorithm>
 
 struct RegionSpace_OffsetTable __RegionSpace_offset__;
 struct RegionSpace_SizeTable __RegionSpace_size__;
@@ -212,9 +215,12 @@ void RegionSpace::Walk(std::function<bool (mirror::Object& object)> fn, bool che
 }
 
 void RegionSpace::WalkInternal(std::function<bool (mirror::Object& object)> visitor, bool only, bool check) {
+    WalkRegions(visitor, 0, num_regions(), only, check);
+}
+
+void RegionSpace::WalkRegions(std::function<bool (mirror::Object& object)> visitor, uint64_t begin, uint64_t end, bool only, bool check) {
     Region regions_(regions(), this);
-    uint64_t num_regions_ = num_regions();
-    for (int i = 0; i < num_regions_; ++i) {
+    for (uint64_t i = begin; i < end; ++i) {
         Region r(regions_.Ptr() + i * SIZEOF(Region), regions_);
         uint64_t pos = r.Begin();
         uint64_t top = r.Top();
@@ -254,7 +260,18 @@ void RegionSpace::WalkNonLargeRegion(std::function<bool (mirror::Object& object)
     if (need_bitmap) {
         GetLiveBitmap().VisitMarkedRange(pos, top, visitor, check);
     } else {
+        // jump over unused tails of thread TLABs instead of probing them.
+        std::vector<std::pair<uint64_t, uint64_t>>& tlabs = Runtime::Current().GetHeap().GetUnusedTlabs();
+        auto tlab = std::upper_bound(tlabs.begin(), tlabs.end(), std::make_pair(pos, static_cast<uint64_t>(0)));
+        if (tlab != tlabs.begin() && std::prev(tlab)->second > pos) --tlab;
+
         while (pos < top) {
+            while (tlab != tlabs.end() && tlab->second <= pos) ++tlab;
+            if (tlab != tlabs.end() && tlab->first <= pos) {
+                pos = tlab->second;
+                continue;
+            }
+
             mirror::Object object(pos, object_cache);
             if (object.IsNonLargeValid()) {
                 visitor(object);
@@ -267,6 +284,26 @@ void RegionSpace::WalkNonLargeRegion(std::function<bool (mirror::Object& object)
     }
 }
 
+void RegionSpace::Partition(std::vector<WalkPartition>& partitions, uint32_t split) {
+    uint64_t num_regions_ = num_regions();
+    if (split <= 1 || num_regions_ <= 1) {
+        Space::Partition(partitions, split);
+        return;
+    }
+
+    // quick cache must be ready before workers share it.
+    GetLiveBitmap();
+    Runtime::Current().GetHeap().GetUnusedTlabs();
+
+    uint64_t step = (num_regions_ + split - 1) / split;
+    for (uint64_t begin = 0; begin < num_regions_; begin += step) {
+        uint64_t end = std::min(begin + step, num_regions_);
+        partitions.push_back([this, begin, end](std::function<bool (mirror::Object& object)> fn, bool check) {
+            WalkRegions(fn, begin, end, false, check);
+        });
+    }
+}
+
 accounting::ContinuousSpaceBitmap& RegionSpace::GetLiveBitmap() {
     if (!mark_bitmap_cache.Ptr()) {
         if (Android::Sdk() > Android::Q) {
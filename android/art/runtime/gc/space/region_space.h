@@ -83,6 +83,8 @@ public:
     SpaceType GetType() { return kSpaceTypeRegionSpace; }
     void Walk(std::function<bool (mirror::Object& object)> fn, bool check);
     void WalkInternal(std::function<bool (mirror::Object& object)> fn, bool only, bool check);
+    void WalkRegions(std::function<bool (mirror::Object& object)> fn, uint64_t begin, uint64_t end, bool only, bool check);
+    void Partition(std::vector<WalkPartition>& partitions, uint32_t split);
 
     enum class RegionType : uint8_t {
         kRegionTypeAll,              // All types.
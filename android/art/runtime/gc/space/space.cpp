@@ -235,6 +235,12 @@ SpaceType Space::GetType() {
     return type_cache;
 }
 
+void Space::Partition(std::vector<WalkPartition>& partitions, uint32_t split) {
+    partitions.push_back([this](std::function<bool (mirror::Object& object)> fn, bool check) {
+        Walk(fn, check);
+    });
+}
+
 uint64_t ContinuousSpace::GetNextObject(mirror::Object& object) {
     const uint64_t position = object.Ptr() + object.SizeOf();
     return RoundUp(position, kObjectAlignment);
@@ -21,6 +21,7 @@
 #include "api/memory_ref.h"
 #include "runtime/mirror/object.h"
 #include <functional>
+#include <vector>
 
 struct Space_OffsetTable {
     uint32_t vtbl;
@@ -98,6 +99,13 @@ public:
     virtual SpaceType GetType();
     virtual void Walk(std::function<bool (mirror::Object& object)> fn, bool check) {}
     virtual bool IsVaildSpace() { return false; }
+
+    /*
+     * Split walk into disjoint partitions ordered by address,
+     * every partition may run on a different worker thread.
+     */
+    typedef std::function<void (std::function<bool (mirror::Object& object)> fn, bool check)> WalkPartition;
+    virtual void Partition(std::vector<WalkPartition>& partitions, uint32_t split);
 private:
     SpaceType type_cache = kSpaceTypeInvalidSpace;
     // quick memoryref cache
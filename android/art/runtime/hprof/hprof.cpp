@@ -17,14 +17,21 @@
 #include "runtime/hprof/hprof.h"
 #include "runtime/runtime.h"
 #include "runtime/gc/heap.h"
+#include "runtime/gc/heap_roots.h"
 #include "runtime/gc/space/space.h"
 #include "runtime/mirror/object.h"
 #include "runtime/mirror/class.h"
 #include "runtime/mirror/array.h"
+#include "runtime/mirror/class_info.h"
 #include "runtime/runtime_globals.h"
 #include "android.h"
+#include "base/byte_swap.h"
+#include "base/thread_pool.h"
+#include "zip/compressor.h"
 #include <vector>
 #include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
 #include <stdio.h>
 
 namespace art {
@@ -32,7 +39,7 @@ namespace hprof {
 
 #define HLOGV(...) \
 do { \
-    if (first_ && visible_) LOGI(__VA_ARGS__); \
+    if (visible_) LOGI(__VA_ARGS__); \
 } while(0)
 
 static constexpr uint32_t kHprofTime = 0;
@@ -196,10 +203,27 @@ public:
 
     void AddIdList(mirror::Array& values) {
         const int32_t length = values.GetLength();
-        for (int32_t i = 0; i < length; ++i) {
-            api::MemoryRef ref(values.GetRawData(sizeof(uint32_t), i), values);
-            art::mirror::Object object(*reinterpret_cast<uint32_t *>(ref.Real()), values);
-            AddObjectId(object);
+        if (length <= 0)
+            return;
+        // heap references are packed 32-bit object ids.
+        api::MemoryRef ref(values.GetRawData(sizeof(uint32_t), 0), values);
+        uint32_t count = 0;
+        uint64_t real;
+        if (ref.TryReal(&real)) {
+            count = length;
+            LoadBlock* block = ref.Block();
+            uint64_t end = ref.Ptr() + static_cast<uint64_t>(length) * sizeof(uint32_t);
+            if (!block->virtualContains(end - 1)) {
+                // corrupt length, only the elements inside the block are readable.
+                uint64_t avail = block->vaddr() + block->size() - (ref.Ptr() & block->VabitsMask());
+                count = avail / sizeof(uint32_t);
+            }
+            AddU4List(reinterpret_cast<uint32_t *>(real), count);
+        }
+        // the record length is already written, read the rest one by one.
+        for (int32_t i = count; i < length; ++i) {
+            api::MemoryRef element(values.GetRawData(sizeof(uint32_t), i), values);
+            AddU4(*reinterpret_cast<uint32_t *>(element.Real()));
         }
     }
 
@@ -265,46 +289,26 @@ protected:
         if (count & 1) {
             buffer_.push_back(0);
         }
-        for (size_t i = 0; i < count; ++i) {
-            uint8_t value = *values;
-            buffer_.push_back(value);
-            values++;
-        }
+        buffer_.insert(buffer_.end(), values, values + count);
     }
 
     void HandleU2List(const uint16_t* values, size_t count) override {
-        for (size_t i = 0; i < count; ++i) {
-            uint16_t value = *values;
-            buffer_.push_back(static_cast<uint8_t>((value >> 8) & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 0) & 0xFF));
-            values++;
-        }
+        ByteSwap::CopyU2(Grow(count * sizeof(uint16_t)), values, count);
     }
 
     void HandleU4List(const uint32_t* values, size_t count) override {
-        for (size_t i = 0; i < count; ++i) {
-            uint32_t value = *values;
-            buffer_.push_back(static_cast<uint8_t>((value >> 24) & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 16) & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 8)  & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 0)  & 0xFF));
-            values++;
-        }
+        ByteSwap::CopyU4(Grow(count * sizeof(uint32_t)), values, count);
     }
 
     void HandleU8List(const uint64_t* values, size_t count) override {
-        for (size_t i = 0; i < count; ++i) {
-            uint64_t value = *values;
-            buffer_.push_back(static_cast<uint8_t>((value >> 56) & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 48) & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 40) & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 32) & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 24) & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 16) & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 8)  & 0xFF));
-            buffer_.push_back(static_cast<uint8_t>((value >> 0)  & 0xFF));
-            values++;
-        }
+        ByteSwap::CopyU8(Grow(count * sizeof(uint64_t)), values, count);
+    }
+
+    // append bytes to the end of buffer_ and return them to be filled.
+    uint8_t* Grow(size_t bytes) {
+        size_t pos = buffer_.size();
+        buffer_.resize(pos + bytes);
+        return buffer_.data() + pos;
     }
 
     void HandleEndRecord() override {
@@ -321,7 +325,9 @@ protected:
 class FileEndianOutput final : public EndianOutputBuffered {
 public:
     FileEndianOutput(FILE* fp, size_t reserved_size)
-        : EndianOutputBuffered(reserved_size), fp_(fp), errors_(false) {
+        : FileEndianOutput(fp, nullptr, reserved_size) {}
+    FileEndianOutput(FILE* fp, Compressor* compressor, size_t reserved_size)
+        : EndianOutputBuffered(reserved_size), fp_(fp), compressor_(compressor), errors_(false) {
         }
 
     ~FileEndianOutput() {
@@ -331,40 +337,61 @@ public:
         return errors_;
     }
 
+    // records already encoded elsewhere, written as is.
+    void WriteRecords(const uint8_t* buffer, size_t length) {
+        HandleFlush(buffer, length);
+    }
+
 protected:
   void HandleFlush(const uint8_t* buffer, size_t length) override {
-      if (!errors_) {
-          errors_ = !fwrite(buffer, length, 1, fp_);
+      if (!errors_ && length) {
+          if (compressor_) {
+              errors_ = !compressor_->Write(buffer, length);
+          } else {
+              errors_ = !fwrite(buffer, length, 1, fp_);
+          }
       }
   }
 
 private:
   FILE* fp_;
+  Compressor* compressor_;
   bool errors_;
 };
 
+/*
+ * Keeps finished records in memory, for heap segments encoded by workers.
+ */
+class MemoryEndianOutput final : public EndianOutputBuffered {
+public:
+    explicit MemoryEndianOutput(size_t reserved_size)
+        : EndianOutputBuffered(reserved_size) {}
+
+    std::vector<uint8_t>& Records() {
+        return records_;
+    }
+
+protected:
+    void HandleFlush(const uint8_t* buffer, size_t length) override {
+        records_.insert(records_.end(), buffer, buffer + length);
+    }
+
+private:
+    std::vector<uint8_t> records_;
+};
+
 #define __ output_->
 
+class HprofSegment;
+
 class Hprof {
 public:
-    Hprof(const char* output, bool visible, bool quick) : filename_(output)
-            ,visible_(visible), quick_(quick), first_(true) {}
+    Hprof(const char* output, bool visible, int compress)
+        : filename_(output), visible_(visible), compress_(compress) {}
 
     void Dump() {
-        LOGI("hprof: heap dump first prepare...\n");
-        // First pass to measure the size of the dump.
-        size_t max_length;
-        {
-            EndianOutput count_output;
-            output_ = &count_output;
-            ProcessHeap(false);
-            max_length = count_output.MaxLength();
-            output_ = nullptr;
-        }
-
         LOGI("hprof: heap dump \"%s\" starting...\n", filename_);
-        first_ = false;
-        bool okay = DumpToFile(max_length);
+        bool okay = DumpToFile();
         if (okay) {
             LOGI("hprof: heap dump completed, scan objects (%lu).\n", total_objects_);
             LOGI("hprof: saved [%s].\n", filename_);
@@ -372,62 +399,61 @@ public:
     }
 
 private:
-    bool DumpHeapObject(mirror::Object& object);
-    void DumpHeapClass(mirror::Class& klass);
-    void DumpHeapArray(mirror::Array& array, mirror::Class& klass);
-    void DumpFakeObjectArray(mirror::Object& object);
-    void DumpHeapInstanceObject(mirror::Object& object, mirror::Class& klass);
-    bool AddRuntimeInternalObjectsField(mirror::Class& klass);
-
-    bool DumpToFile(size_t max_length) {
+    friend class HprofSegment;
+
+    /*
+     * Single parallel heap walk. Every partition of the heap is encoded by a
+     * worker into its own HEAP_DUMP_SEGMENT records, strings and classes are
+     * interned into the shared tables. Partitions are appended in address
+     * order, each one right after the STRING and LOAD_CLASS records interned
+     * so far, so every id is still defined before it is used.
+     */
+    bool DumpToFile() {
         FILE *fp = fopen(filename_, "wb");
         if (!fp)
             return false;
 
-        FileEndianOutput file_output(fp, max_length);
+        // records of both outputs go through the same compressed stream.
+        std::unique_ptr<Compressor> compressor;
+        if (compress_ != Compressor::TYPE_NONE) {
+            compressor = Compressor::Create(fp, compress_, ThreadPool::GetWorkers());
+            if (!compressor) {
+                LOGE("hprof: not support compress type (%d).\n", compress_);
+                fclose(fp);
+                return false;
+            }
+        }
+
+        FileEndianOutput file_output(fp, compressor.get(), kMaxBytesPerSegment * 2);
+        FileEndianOutput table_output(fp, compressor.get(), kMaxBytesPerSegment);
         output_ = &file_output;
-        ProcessHeap(true);
+        table_output_ = &table_output;
+        file_output_ = &file_output;
+        ProcessHeap();
+        output_ = nullptr;
+        table_output_ = nullptr;
+        file_output_ = nullptr;
+        bool compress_errors = compressor && (!compressor->Finish() || compressor->Errors());
         fclose(fp);
-        return true;
-    }
 
-    void ProcessHeap(bool header_first) {
-        current_heap_ = HPROF_HEAP_DEFAULT;
-        objects_in_segment_ = 0;
-        if (header_first) {
-            ProcessHeader(true);
-            ProcessBody();
-        } else {
-            ProcessBody();
-            ProcessHeader(false);
+        if (file_output.Errors() || table_output.Errors() || compress_errors) {
+            LOGE("hprof: write \"%s\" fail.\n", filename_);
+            return false;
         }
+        return true;
     }
 
-    void ProcessBody() {
-        // Walk the roots and the heap.
-        output_->StartNewRecord(HPROF_TAG_HEAP_DUMP_SEGMENT, 0x0);
-        auto callback = [&](art::mirror::Object& object) -> bool {
-            return DumpHeapObject(object);
-        };
-        Android::ForeachObjects(callback);
-        output_->StartNewRecord(HPROF_TAG_HEAP_DUMP_END, 0x0);
-        output_->EndRecord();
-    }
-
-    void ProcessHeader(bool string_first) {
+    void ProcessHeap() {
+        class_info_ = &Runtime::Current().GetHeap().GetClassInfoCache();
         WriteFixedHeader();
-
-        if (string_first) {
-            WriteStringTable();
-        }
-        WriteClassTable();
         WriteStackTraces();
-        if (!string_first) {
-            WriteStringTable();
-        }
         output_->EndRecord();
+        ProcessBody();
     }
 
+    void ProcessBody();
+    void WriteRoots();
+
     void WriteFixedHeader() {
         char magic[] = "JAVA PROFILE 1.0.3";
         __ AddU1List(reinterpret_cast<uint8_t*>(magic), sizeof(magic));
@@ -436,10 +462,30 @@ private:
         __ AddU4(0x0);
     }
 
-    void WriteStringTable() {
-        for (const auto& p : strings_) {
-            const std::string& string = p.first;
-            const HprofStringId id = p.second;
+    void WritePendingTables() {
+        std::vector<std::pair<HprofStringId, const std::string*>> strings;
+        std::vector<std::pair<mirror::Class, HprofClassSerialNumber>> classes;
+        {
+            // take both together, a class name is never behind its class.
+            std::unique_lock<std::shared_mutex> guard(lock_);
+            strings.swap(pending_strings_);
+            classes.swap(pending_classes_);
+        }
+        if (strings.empty() && classes.empty())
+            return;
+
+        EndianOutput* segment_output = output_;
+        output_ = table_output_;
+        WriteStringTable(strings);
+        WriteClassTable(classes);
+        output_->EndRecord();
+        output_ = segment_output;
+    }
+
+    void WriteStringTable(std::vector<std::pair<HprofStringId, const std::string*>>& pending_strings) {
+        for (const auto& p : pending_strings) {
+            const std::string& string = *p.second;
+            const HprofStringId id = p.first;
 
             output_->StartNewRecord(HPROF_TAG_STRING, kHprofTime);
 
@@ -448,8 +494,8 @@ private:
         }
     }
 
-    void WriteClassTable() {
-        for (const auto& p : classes_) {
+    void WriteClassTable(std::vector<std::pair<mirror::Class, HprofClassSerialNumber>>& pending_classes) {
+        for (const auto& p : pending_classes) {
             mirror::Class c = p.first;
             HprofClassSerialNumber sn = p.second;
             output_->StartNewRecord(HPROF_TAG_LOAD_CLASS, kHprofTime);
@@ -468,36 +514,113 @@ private:
         __ AddU4(0);
     }
 
+    /*
+     * Interning tables are shared by all workers, ids are handed out on
+     * first sight and the new entries queued until the next WritePendingTables.
+     */
     HprofStringId LookupStringId(const std::string& string) {
+        {
+            std::shared_lock<std::shared_mutex> guard(lock_);
+            auto it = strings_.find(string);
+            if (it != strings_.end())
+                return it->second;
+        }
+        std::unique_lock<std::shared_mutex> guard(lock_);
+        return LookupStringIdLocked(string);
+    }
+
+    HprofStringId LookupStringIdLocked(const std::string& string) {
         auto it = strings_.find(string);
         if (it != strings_.end()) {
             return it->second;
         }
 
         HprofStringId id = next_string_id_++;
-        strings_.insert(std::pair<std::string, HprofStringId>(string, id));
+        auto result = strings_.insert(std::pair<std::string, HprofStringId>(string, id));
+        pending_strings_.push_back(std::pair<HprofStringId, const std::string*>(id, &result.first->first));
         return id;
     }
 
     HprofStringId LookupClassNameId(mirror::Class& c) {
-        std::string desc = c.PrettyDescriptor();
-        return LookupStringId(desc);
+        return LookupStringId(class_info_->GetDescriptor(c));
     }
 
     HprofClassObjectId LookupClassId(mirror::Class& c) {
         if (c.Ptr()) {
+            {
+                std::shared_lock<std::shared_mutex> guard(lock_);
+                if (classes_.find(c) != classes_.end())
+                    return c.Ptr();
+            }
+            const std::string& descriptor = class_info_->GetDescriptor(c);
+            std::unique_lock<std::shared_mutex> guard(lock_);
             auto it = classes_.find(c);
             if (it == classes_.end()) {
                 // first time to see this class
                 HprofClassSerialNumber sn = next_class_serial_number_++;
                 // Make sure that we've assigned a string ID for this class' name
-                LookupClassNameId(c);
+                LookupStringIdLocked(descriptor);
                 classes_.insert(std::pair<mirror::Class, HprofClassSerialNumber>(c, sn));
+                pending_classes_.push_back(std::pair<mirror::Class, HprofClassSerialNumber>(c, sn));
             }
         }
         return c.Ptr();
     }
 
+    const char* filename_;
+    bool visible_;
+    int compress_;
+    mirror::ClassInfoCache* class_info_ = nullptr;
+
+    EndianOutput* output_ = nullptr;
+    EndianOutput* table_output_ = nullptr;
+    FileEndianOutput* file_output_ = nullptr;
+
+    size_t total_objects_ = 0u;
+
+    std::shared_mutex lock_;
+    HprofStringId next_string_id_ = 0x400000;
+    std::unordered_map<std::string, HprofStringId> strings_;
+    std::vector<std::pair<HprofStringId, const std::string*>> pending_strings_;
+
+    HprofClassSerialNumber next_class_serial_number_ = 1;
+    std::unordered_map<mirror::Class, HprofClassSerialNumber, mirror::Class::Hash> classes_;
+    std::vector<std::pair<mirror::Class, HprofClassSerialNumber>> pending_classes_;
+};
+
+/*
+ * Encoder of one heap partition, owned by a single worker.
+ */
+class HprofSegment {
+public:
+    HprofSegment() : records_(kMaxBytesPerSegment * 2) {}
+
+    void Attach(Hprof* hprof) {
+        hprof_ = hprof;
+        visible_ = hprof->visible_;
+        class_info_ = hprof->class_info_;
+        output_ = &records_;
+        output_->StartNewRecord(HPROF_TAG_HEAP_DUMP_SEGMENT, kHprofTime);
+    }
+    inline bool IsAttached() { return hprof_ != nullptr; }
+
+    bool DumpHeapObject(mirror::Object& object);
+
+    std::vector<uint8_t>& Finish() {
+        output_->EndRecord();
+        return records_.Records();
+    }
+    inline size_t TotalObjects() { return total_objects_; }
+private:
+    void DumpHeapClass(mirror::Class& klass);
+    void DumpHeapArray(mirror::Array& array, mirror::Class& klass);
+    void DumpFakeObjectArray(mirror::Object& object);
+    void DumpHeapInstanceObject(mirror::Object& object, mirror::Class& klass);
+    bool AddRuntimeInternalObjectsField(mirror::Class& klass);
+
+    inline HprofStringId LookupStringId(const std::string& string) { return hprof_->LookupStringId(string); }
+    inline HprofClassObjectId LookupClassId(mirror::Class& c) { return hprof_->LookupClassId(c); }
+
     void StartNewHeapDumpSegment() {
         // This flushes the old segment and starts a new one.
         output_->StartNewRecord(HPROF_TAG_HEAP_DUMP_SEGMENT, kHprofTime);
@@ -513,25 +636,93 @@ private:
         }
     }
 
-    const char* filename_;
-    bool visible_;
-    bool quick_;
-    bool first_;
+    Hprof* hprof_ = nullptr;
+    bool visible_ = false;
+    mirror::ClassInfoCache* class_info_ = nullptr;
 
+    MemoryEndianOutput records_;
     EndianOutput* output_ = nullptr;
     HprofHeapId current_heap_ = HPROF_HEAP_DEFAULT;  // Which heap we're currently dumping.
     size_t objects_in_segment_ = 0;
-
     size_t total_objects_ = 0u;
+};
 
-    HprofStringId next_string_id_ = 0x400000;
-    std::unordered_map<std::string, HprofStringId> strings_;
+/*
+ * Roots go in their own HEAP_DUMP_SEGMENT records ahead of the objects,
+ * thread serial is the art thread id. Weak globals are not roots.
+ */
+void Hprof::WriteRoots() {
+    gc::HeapRoots& roots = Runtime::Current().GetHeap().GetHeapRoots();
+    size_t roots_in_segment = 0;
+    output_->StartNewRecord(HPROF_TAG_HEAP_DUMP_SEGMENT, kHprofTime);
+    for (const auto& root : roots.GetRoots()) {
+        if (roots_in_segment >= kMaxObjectsPerSegment
+                || output_->Length() >= kMaxBytesPerSegment) {
+            output_->StartNewRecord(HPROF_TAG_HEAP_DUMP_SEGMENT, kHprofTime);
+            roots_in_segment = 0;
+        }
 
-    HprofClassSerialNumber next_class_serial_number_ = 1;
-    std::unordered_map<mirror::Class, HprofClassSerialNumber, mirror::Class::Hash> classes_;
-};
+        mirror::Object object = root.ref;
+        switch (root.type) {
+            case gc::kRootJNIGlobal:
+                __ AddU1(HPROF_ROOT_JNI_GLOBAL);
+                __ AddObjectId(object);
+                __ AddU4(root.index);
+                break;
+            case gc::kRootJNILocal:
+                __ AddU1(HPROF_ROOT_JNI_LOCAL);
+                __ AddObjectId(object);
+                __ AddU4(root.thread_id);
+                __ AddU4(root.index);
+                break;
+            case gc::kRootJavaFrame:
+                __ AddU1(HPROF_ROOT_JAVA_FRAME);
+                __ AddObjectId(object);
+                __ AddU4(root.thread_id);
+                __ AddU4(root.index);
+                break;
+            case gc::kRootStickyClass:
+                __ AddU1(HPROF_ROOT_STICKY_CLASS);
+                __ AddObjectId(object);
+                break;
+            case gc::kRootThreadObject:
+                __ AddU1(HPROF_ROOT_THREAD_OBJECT);
+                __ AddObjectId(object);
+                __ AddU4(root.thread_id);
+                __ AddStackTraceSerialNumber(kHprofNullStackTrace);
+                break;
+            default:
+                continue;
+        }
+        ++roots_in_segment;
+    }
+    output_->EndRecord();
+}
 
-bool Hprof::AddRuntimeInternalObjectsField(mirror::Class& klass) {
+void Hprof::ProcessBody() {
+    WriteRoots();
+
+    // Walk the heap.
+    auto callback = [&](HprofSegment& segment, art::mirror::Object& object) -> bool {
+        if (!segment.IsAttached())
+            segment.Attach(this);
+        return segment.DumpHeapObject(object);
+    };
+    auto merge = [&](HprofSegment& segment) {
+        std::vector<uint8_t>& records = segment.Finish();
+        WritePendingTables();
+        file_output_->WriteRecords(records.data(), records.size());
+        total_objects_ += segment.TotalObjects();
+    };
+    Android::ParallelForeachObjects<HprofSegment>(callback, merge,
+            Android::EACH_IMAGE_OBJECTS | Android::EACH_ZYGOTE_OBJECTS
+                    | Android::EACH_APP_OBJECTS | Android::EACH_FAKE_OBJECTS, false);
+    WritePendingTables();
+    output_->StartNewRecord(HPROF_TAG_HEAP_DUMP_END, kHprofTime);
+    output_->EndRecord();
+}
+
+bool HprofSegment::AddRuntimeInternalObjectsField(mirror::Class& klass) {
     if (klass.IsDexCacheClass())
         return true;
 
@@ -543,14 +734,12 @@ bool Hprof::AddRuntimeInternalObjectsField(mirror::Class& klass) {
     return false;
 }
 
-bool Hprof::DumpHeapObject(mirror::Object& object) {
-    if (object.IsClass()) {
+bool HprofSegment::DumpHeapObject(mirror::Object& object) {
+    const mirror::ClassInfo& info = class_info_->GetClassInfoOf(object);
+    if (info.IsClass()) {
         mirror::Class thiz = object;
         if (thiz.IsRetired())
             return false;
-    } else {
-        if (quick_ && first_)
-            return false;
     }
 
     ++total_objects_;
@@ -597,10 +786,10 @@ bool Hprof::DumpHeapObject(mirror::Object& object) {
 
     mirror::Class klass = object.GetClass();
     if (klass.Ptr()) {
-        if (object.IsClass()) {
+        if (info.IsClass()) {
             mirror::Class thiz = object;
             DumpHeapClass(thiz);
-        } else if (klass.IsArrayClass()) {
+        } else if (info.IsArray()) {
             mirror::Array thiz = object;
             DumpHeapArray(thiz, klass);
         } else {
@@ -611,7 +800,7 @@ bool Hprof::DumpHeapObject(mirror::Object& object) {
     return false;
 }
 
-void Hprof::DumpHeapClass(mirror::Class& klass) {
+void HprofSegment::DumpHeapClass(mirror::Class& klass) {
     if (!klass.IsResolved())
         return;
 
@@ -800,7 +989,7 @@ void Hprof::DumpHeapClass(mirror::Class& klass) {
     }
 }
 
-void Hprof::DumpHeapArray(mirror::Array& array, mirror::Class& klass) {
+void HprofSegment::DumpHeapArray(mirror::Array& array, mirror::Class& klass) {
     HLOGV("%s 0x%lx\n", __func__, array.Ptr());
     HLOGV("%s\n", klass.PrettyDescriptor().c_str());
 
@@ -846,7 +1035,7 @@ void Hprof::DumpHeapArray(mirror::Array& array, mirror::Class& klass) {
     }
 }
 
-void Hprof::DumpHeapInstanceObject(mirror::Object& object, mirror::Class& klass) {
+void HprofSegment::DumpHeapInstanceObject(mirror::Object& object, mirror::Class& klass) {
     HLOGV("%s 0x%lx\n", __func__, object.Ptr());
     HLOGV("%s\n", klass.PrettyDescriptor().c_str());
 
@@ -933,7 +1122,7 @@ void Hprof::DumpHeapInstanceObject(mirror::Object& object, mirror::Class& klass)
     }
 }
 
-void Hprof::DumpFakeObjectArray(mirror::Object& object) {
+void HprofSegment::DumpFakeObjectArray(mirror::Object& object) {
     __ AddU1(HPROF_OBJECT_ARRAY_DUMP);
     __ AddObjectId(object);
     __ AddStackTraceSerialNumber(kHprofNullStackTrace);
@@ -941,8 +1130,12 @@ void Hprof::DumpFakeObjectArray(mirror::Object& object) {
     __ AddClassId(0);
 }
 
-void DumpHeap(const char* output, bool visible, bool quick) {
-    Hprof hprof(output, visible, quick);
+void DumpHeap(const char* output, bool visible) {
+    DumpHeap(output, visible, Compressor::TYPE_NONE);
+}
+
+void DumpHeap(const char* output, bool visible, int compress) {
+    Hprof hprof(output, visible, compress);
     hprof.Dump();
 }
 
@@ -22,7 +22,9 @@
 namespace art {
 namespace hprof {
 
-void DumpHeap(const char* output, bool visible, bool quick);
+void DumpHeap(const char* output, bool visible);
+// compress is one of Compressor::TYPE_*
+void DumpHeap(const char* output, bool visible, int compress);
 
 } // namespace hprof
 } // namespace art
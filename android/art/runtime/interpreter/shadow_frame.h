@@ -59,6 +59,8 @@ public:
     inline uint32_t number_of_vregs() { return value32Of(OFFSET(ShadowFrame, number_of_vregs_)); }
     inline uint32_t dex_pc() { return value32Of(OFFSET(ShadowFrame, dex_pc_)); }
     inline uint64_t vregs() { return Ptr() + OFFSET(ShadowFrame, vregs_); }
+    // reference array follows vregs_, one slot per vreg.
+    inline uint64_t references() { return vregs() + number_of_vregs() * sizeof(uint32_t); }
 
     inline ArtMethod GetMethod() { return method(); }
     uint64_t GetDexPcPtr();
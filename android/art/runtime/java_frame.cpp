@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include "android.h"
 #include "runtime/java_frame.h"
+#include "runtime/nterp_helpers.h"
 
 namespace art {
 
@@ -27,4 +29,41 @@ uint64_t JavaFrame::GetDexPcPtr() {
     return 0x0;
 }
 
+void JavaFrame::VisitReferences(std::function<void (uint32_t ref)> fn) {
+    if (shadow_frame.Ptr()) {
+        api::MemoryRef references(shadow_frame.references(), shadow_frame);
+        uint32_t number_of_vregs = shadow_frame.number_of_vregs();
+        for (uint32_t i = 0; i < number_of_vregs; ++i) {
+            uint32_t ref = references.value32Of(i * sizeof(uint32_t));
+            if (ref) fn(ref);
+        }
+    } else if (quick_frame.Ptr()) {
+        if (GetMethod().IsNative()) {
+            return;
+        }
+
+        OatQuickMethodHeader& method_header = quick_frame.GetMethodHeader();
+        if (!method_header.Ptr()) {
+            return;
+        }
+
+        if (method_header.IsOptimized()) {
+            std::vector<uint32_t> slots;
+            uint32_t native_pc = static_cast<uint32_t>(quick_frame.GetFramePc() - method_header.GetCodeStart());
+            method_header.NativePc2StackMask(native_pc, slots);
+            for (uint32_t slot : slots) {
+                uint32_t ref = quick_frame.value32Of(slot * kFrameSlotSize);
+                if (ref) fn(ref);
+            }
+        } else if (Android::Sdk() >= Android::R) {
+            api::MemoryRef references(NterpGetReferenceArray(quick_frame), quick_frame);
+            uint32_t num_regs = GetMethod().GetCodeItem().num_regs_;
+            for (uint32_t i = 0; i < num_regs; ++i) {
+                uint32_t ref = references.value32Of(i * sizeof(uint32_t));
+                if (ref) fn(ref);
+            }
+        }
+    }
+}
+
 } // namespace art
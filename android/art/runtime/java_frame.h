@@ -23,6 +23,7 @@
 #include "runtime/interpreter/shadow_frame.h"
 #include "runtime/oat/stack_map.h"
 #include <vector>
+#include <functional>
 
 namespace art {
 
@@ -46,6 +47,12 @@ public:
         return empty_vregs;
     }
     void SetPrevQuickFrame(QuickFrame& qf) { prev_quick_frame = qf; }
+    /*
+     * Live references held by this frame: reference array of shadow and nterp
+     * frames, stack mask of optimized frames. References kept only in callee
+     * save registers are not recoverable and not visited.
+     */
+    void VisitReferences(std::function<void (uint32_t ref)> fn);
 private:
     ArtMethod method;
     ShadowFrame shadow_frame = 0x0;
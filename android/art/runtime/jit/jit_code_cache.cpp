@@ -19,7 +19,9 @@
 #include "android.h"
 #include "runtime/jit/jit_code_cache.h"
 #include "cxx/vector.h"
-#include <limits>
+#include "common/exception.h"
+#include <algorithm>
+#include <mutex>
 
 struct JitCodeCache_OffsetTable __JitCodeCache_offset__;
 struct JniStubsMapPair_OffsetTable __JniStubsMapPair_offset__;
@@ -315,27 +317,51 @@ uint64_t ZygoteMap::GetCodeFor(ArtMethod& method, uint64_t pc) {
     return 0x0;
 }
 
+std::vector<JitCodeCache::MethodCode>& JitCodeCache::GetMethodCodes() {
+    // may be first touched by parallel stack walkers, lookups don't lock once built.
+    std::call_once(*method_codes_once, [&] {
+        // a throwing walk leaves the flag unset, start over next time.
+        method_codes_second_cache.clear();
+        // SafeMap<const void*, ArtMethod*> method_code_map_ GUARDED_BY(lock_);
+        uint32_t point_size = CoreApi::GetPointSize();
+        for (const auto& value : GetMethodCodeMap()) {
+            api::MemoryRef ref = value;
+            MethodCode code;
+            code.code_begin = ref.valueOf();
+            code.method = ref.valueOf(point_size);
+            try {
+                OatQuickMethodHeader method_header = OatQuickMethodHeader::FromCodePointer(code.code_begin);
+                code.code_end = method_header.GetCodeStart() + method_header.GetCodeSize();
+            } catch(InvalidAddressException e) {
+                // unknown size, let callers check the header.
+                code.code_end = 0x0;
+            }
+            method_codes_second_cache.push_back(code);
+        }
+
+        std::sort(method_codes_second_cache.begin(), method_codes_second_cache.end(),
+                [](const MethodCode& a, const MethodCode& b) {
+            return a.code_begin < b.code_begin;
+        });
+    });
+    return method_codes_second_cache;
+}
+
 OatQuickMethodHeader JitCodeCache::LookupMethodCodeMap(uint64_t pc, ArtMethod& /*method*/) {
-    if (!GetMethodCodeMap().size()) {
+    std::vector<MethodCode>& codes = GetMethodCodes();
+
+    // last code_begin <= pc.
+    auto it = std::upper_bound(codes.begin(), codes.end(), pc, [](uint64_t value, const MethodCode& code) {
+        return value < code.code_begin;
+    });
+    if (it == codes.begin())
         return 0x0;
-    }
+    --it;
 
-    uint64_t code_ptr;
-    uint32_t point_size = CoreApi::GetPointSize();
-    uint64_t nice = std::numeric_limits<uint64_t>::max();
-    for (const auto& value : GetMethodCodeMap()) {
-        api::MemoryRef ref = value;
-        uint64_t tmp_pc = ref.valueOf();
-        if (pc < tmp_pc)
-            continue;
-
-        if (pc - tmp_pc <= nice) {
-            nice = pc - tmp_pc;
-            code_ptr = tmp_pc;
-        }
-    }
+    if (it->code_end && pc > it->code_end)
+        return 0x0;
 
-    return OatQuickMethodHeader::FromCodePointer(code_ptr);
+    return OatQuickMethodHeader::FromCodePointer(it->code_begin);
 }
 
 OatQuickMethodHeader JitCodeCache::LookupMethodHeader(uint64_t pc, ArtMethod& method) {
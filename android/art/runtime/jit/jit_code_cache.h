@@ -22,6 +22,9 @@
 #include "runtime/jit/jit_memory_region.h"
 #include "base/mem_map.h"
 #include "cxx/map.h"
+#include <vector>
+#include <memory>
+#include <mutex>
 
 struct JitCodeCache_OffsetTable {
     uint32_t code_map_;
@@ -108,6 +111,14 @@ public:
     MemMap& GetZygoteExecPages();
     ZygoteMap& GetZygoteMap();
 
+    // decoded method_code_map_, sorted by code_begin.
+    struct MethodCode {
+        uint64_t code_begin;
+        uint64_t code_end;
+        uint64_t method;
+    };
+    std::vector<MethodCode>& GetMethodCodes();
+
     OatQuickMethodHeader LookupMethodHeader(uint64_t pc, ArtMethod& method);
     OatQuickMethodHeader LookupMethodCodeMap(uint64_t pc, ArtMethod& method);
     bool PrivateRegionContainsPc(uint64_t pc);
@@ -155,6 +166,10 @@ private:
     cxx::map method_code_map_cache = 0x0;
     MemMap zygote_exec_pages_cache = 0x0;
     ZygoteMap zygote_map_cache = 0x0;
+
+    // second cache
+    std::vector<MethodCode> method_codes_second_cache;
+    std::unique_ptr<std::once_flag> method_codes_once = std::make_unique<std::once_flag>();
 };
 
 } // namespace jit
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/core.h"
+#include "android.h"
+#include "runtime/jni/jni_env_ext.h"
+
+struct JNIEnvExt_OffsetTable __JNIEnvExt_offset__;
+
+namespace art {
+
+void JNIEnvExt::Init() {
+    Android::RegisterSdkListener(Android::O, art::JNIEnvExt::Init26);
+}
+
+void JNIEnvExt::Init26() {
+    if (CoreApi::Bits() == 64) {
+        __JNIEnvExt_offset__ = {
+            .self_ = 8,
+            .vm_ = 16,
+            .local_ref_cookie_ = 24,
+            .locals_ = 32,
+        };
+    } else {
+        __JNIEnvExt_offset__ = {
+            .self_ = 4,
+            .vm_ = 8,
+            .local_ref_cookie_ = 12,
+            .locals_ = 16,
+        };
+    }
+}
+
+bool JNIEnvExt::HasIndirectLocals() {
+    return Android::Sdk() < Android::U;
+}
+
+IndirectReferenceTable& JNIEnvExt::GetLocalsTable() {
+    if (!locals_cache.Ptr()) {
+        locals_cache = locals();
+        locals_cache.copyRef(this);
+    }
+    return locals_cache;
+}
+
+} //namespace art
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "android.h"
+#include "runtime/mirror/class_info.h"
+#include "runtime/mirror/array.h"
+#include "runtime/mirror/string.h"
+#include "runtime/art_field.h"
+#include "common/bit.h"
+#include <mutex>
+#include <string.h>
+
+namespace art {
+namespace mirror {
+
+uint64_t ClassInfo::SizeOf(Object& object) const {
+    switch (kind) {
+        case kInstance:
+            return object_size;
+        case kString: {
+            String value = object;
+            return value.SizeOf();
+        }
+        case kClass: {
+            Class clazz = object;
+            return clazz.SizeOf();
+        }
+        case kObjectArray:
+        case kPrimitiveArray: {
+            Array array = object;
+            size_t header_size = RoundUp(0xC, 1U << component_size_shift);
+            size_t data_size = array.GetLength() << component_size_shift;
+            return header_size + data_size;
+        }
+    }
+    return 0x0;
+}
+
+void ClassInfo::ForeachReferenceOffset(std::function<void (uint32_t offset)> fn) const {
+    for (uint32_t i = 0; i < reference_bitmap.size(); ++i) {
+        uint32_t word = reference_bitmap[i];
+        while (word) {
+            uint32_t bit = __builtin_ctz(word);
+            fn(((i << 5) + bit) * sizeof(uint32_t));
+            word &= word - 1;
+        }
+    }
+}
+
+void ClassInfoCache::Decode(Class& clazz, ClassInfo& info) {
+    info.klass = clazz.Ptr();
+    if (clazz.IsClassClass()) {
+        info.kind = ClassInfo::kClass;
+    } else if (clazz.IsArrayClass()) {
+        Class component = clazz.GetComponentType();
+        info.kind = component.IsPrimitive() ? ClassInfo::kPrimitiveArray : ClassInfo::kObjectArray;
+        info.component_size_shift = component.GetPrimitiveTypeSizeShift();
+    } else if (clazz.IsStringClass()) {
+        info.kind = ClassInfo::kString;
+    } else {
+        info.kind = ClassInfo::kInstance;
+    }
+    info.object_size = clazz.GetObjectSize();
+    info.descriptor = clazz.PrettyDescriptor();
+
+    bool is_reference = info.kind == ClassInfo::kInstance
+            && (clazz.GetClassFlags() & kClassFlagReference) != 0x0;
+    auto callback = [&](ArtField& field) -> bool {
+        const char* type = field.GetTypeDescriptor();
+        if (type[0] == 'L' || type[0] == '[') {
+            uint32_t slot = field.offset() / sizeof(uint32_t);
+            if (is_reference && !strcmp(field.GetName(), "referent"))
+                info.referent_offset = field.offset();
+            if ((slot >> 5) >= info.reference_bitmap.size())
+                info.reference_bitmap.resize((slot >> 5) + 1, 0);
+            info.reference_bitmap[slot >> 5] |= 1U << (slot & 0x1F);
+        }
+        return false;
+    };
+    Class super = clazz;
+    do {
+        Android::ForeachInstanceField(super, callback);
+        super = super.GetSuperClass();
+    } while (super.Ptr());
+}
+
+const ClassInfo& ClassInfoCache::GetClassInfo(Class& clazz) {
+    {
+        std::shared_lock<std::shared_mutex> guard(lock_);
+        auto it = classes_.find(clazz.Ptr());
+        if (it != classes_.end())
+            return it->second;
+    }
+
+    // decode out of lock, the first inserted one wins.
+    ClassInfo info;
+    Decode(clazz, info);
+
+    std::unique_lock<std::shared_mutex> guard(lock_);
+    return classes_.emplace(clazz.Ptr(), std::move(info)).first->second;
+}
+
+uint32_t ClassInfoCache::NumberOfClasses() {
+    std::shared_lock<std::shared_mutex> guard(lock_);
+    return classes_.size();
+}
+
+} // namespace mirror
+} // namespace art
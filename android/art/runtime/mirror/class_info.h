@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ANDROID_ART_RUNTIME_MIRROR_CLASS_INFO_H_
+#define ANDROID_ART_RUNTIME_MIRROR_CLASS_INFO_H_
+
+#include "runtime/mirror/object.h"
+#include "runtime/mirror/class.h"
+#include <stdint.h>
+#include <sys/types.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+#include <functional>
+
+namespace art {
+namespace mirror {
+
+/*
+ * Decoded facts of one Class which heap walkers need for every instance,
+ * resolved once and shared by all walkers of the session.
+ */
+class ClassInfo {
+public:
+    enum Kind {
+        kInstance,
+        kString,
+        kClass,
+        kObjectArray,
+        kPrimitiveArray,
+    };
+
+    uint32_t klass = 0x0;
+    Kind kind = kInstance;
+    std::string descriptor;
+    uint32_t object_size = 0;
+    uint32_t component_size_shift = 0;
+    // bit n means a heap reference at offset (n * sizeof(uint32_t)), klass_ included.
+    std::vector<uint32_t> reference_bitmap;
+    // offset of Reference.referent for soft/weak/phantom/finalizer references, 0 otherwise.
+    uint32_t referent_offset = 0;
+
+    inline bool IsInstance() const { return kind == kInstance; }
+    inline bool IsString() const { return kind == kString; }
+    inline bool IsClass() const { return kind == kClass; }
+    inline bool IsObjectArray() const { return kind == kObjectArray; }
+    inline bool IsPrimitiveArray() const { return kind == kPrimitiveArray; }
+    inline bool IsArray() const { return kind == kObjectArray || kind == kPrimitiveArray; }
+    inline bool IsReference() const { return referent_offset != 0; }
+
+    uint64_t SizeOf(Object& object) const;
+    void ForeachReferenceOffset(std::function<void (uint32_t offset)> fn) const;
+};
+
+class ClassInfoCache {
+public:
+    ClassInfoCache() {}
+    ~ClassInfoCache() {}
+
+    // thread safe, returned info is stable until the cache is cleaned.
+    const ClassInfo& GetClassInfo(Class& clazz);
+    inline const ClassInfo& GetClassInfoOf(Object& object) {
+        Class clazz = object.GetClass();
+        return GetClassInfo(clazz);
+    }
+    inline const std::string& GetDescriptor(Class& clazz) { return GetClassInfo(clazz).descriptor; }
+    inline uint64_t SizeOf(Object& object) { return GetClassInfoOf(object).SizeOf(object); }
+    uint32_t NumberOfClasses();
+private:
+    static void Decode(Class& clazz, ClassInfo& info);
+
+    std::shared_mutex lock_;
+    std::unordered_map<uint32_t, ClassInfo> classes_;
+};
+
+} // namespace mirror
+} // namespace art
+
+#endif // ANDROID_ART_RUNTIME_MIRROR_CLASS_INFO_H_
@@ -160,44 +160,95 @@ uint32_t Object::GetLockOwnerThreadId() {
     return Monitor::GetLockOwnerThreadId(*this);
 }
 
-bool Object::IsValid() {
-    try {
-        Class klass_ = GetClass();
-        if (klass_.Ptr() == 0x0 || klass_.Ptr() == kPoisonDeadObject)
+bool Object::TryValidSizeOf(int64_t* size) {
+    uint32_t klass_ptr;
+    if (!TryValue32Of(OFFSET(Object, klass_), &klass_ptr))
+        return false;
+    if (klass_ptr == 0x0 || klass_ptr == kPoisonDeadObject)
+        return false;
+
+    // klass_ must be an instance of java.lang.Class
+    Class klass_(klass_ptr, this);
+    uint32_t java_lang_Class;
+    uint32_t java_lang_Class_klass;
+    if (!klass_.TryValue32Of(OFFSET(Object, klass_), &java_lang_Class) || !java_lang_Class)
+        return false;
+    Class klass_klass_(java_lang_Class, klass_);
+    if (!klass_klass_.TryValue32Of(OFFSET(Object, klass_), &java_lang_Class_klass)
+            || java_lang_Class != java_lang_Class_klass)
+        return false;
+
+    uint32_t component_type;
+    if (!klass_.TryValue32Of(OFFSET(Class, component_type_), &component_type))
+        return false;
+
+    if (component_type) {
+        Class component_type_(component_type, klass_);
+        uint32_t primitive_type;
+        uint32_t length;
+        if (!component_type_.TryValue32Of(OFFSET(Class, primitive_type_), &primitive_type)
+                || !TryValue32Of(OFFSET(Array, length_), &length))
+            return false;
+        int32_t component_count = length;
+        uint64_t component_size_shift = primitive_type >> kPrimitiveTypeSizeShiftShift;
+        size_t header_size = RoundUp(0xC, 1U << component_size_shift);
+        size_t data_size = component_count << component_size_shift;
+        *size = header_size + data_size;
+    } else if (klass_ptr == java_lang_Class) {
+        uint32_t class_size;
+        if (!TryValue32Of(OFFSET(Class, class_size_), &class_size))
+            return false;
+        *size = class_size;
+    } else {
+        uint32_t class_flags;
+        if (!klass_.TryValue32Of(OFFSET(Class, class_flags_), &class_flags))
             return false;
 
-        if (LIKELY(klass_.IsClass())
-                && LIKELY(!((int64_t)SizeOf() < (int64_t)kObjectAlignment)))
-            return true;
-    } catch (InvalidAddressException e) {
-        // do nothing
+        if (class_flags & kClassFlagString) {
+            uint32_t count;
+            if (!TryValue32Of(OFFSET(String, count_), &count))
+                return false;
+            uint64_t length = count >> 1;
+            uint64_t string_size = SIZEOF(String);
+            if ((count & 1u) == static_cast<uint32_t>(StringCompressionFlag::kCompressed)) {
+                string_size += sizeof(uint8_t) * length;
+            } else {
+                string_size += sizeof(uint16_t) * length;
+            }
+            *size = RoundUp(string_size, kObjectAlignment);
+        } else {
+            uint32_t object_size;
+            if (!klass_.TryValue32Of(OFFSET(Class, object_size_), &object_size))
+                return false;
+            *size = object_size;
+        }
     }
-    return false;
+    return true;
+}
+
+bool Object::IsValid() {
+    int64_t thiz_size;
+    if (!TryValidSizeOf(&thiz_size))
+        return false;
+
+    return LIKELY(!(thiz_size < (int64_t)kObjectAlignment));
 }
 
 bool Object::IsNonLargeValid() {
-    try {
-        Class klass_ = GetClass();
-        if (klass_.Ptr() == 0x0 || klass_.Ptr() == kPoisonDeadObject)
-            return false;
+    int64_t thiz_size;
+    if (!TryValidSizeOf(&thiz_size))
+        return false;
 
-        if (LIKELY(klass_.IsClass())) {
-            int64_t thiz_size = SizeOf();
-            if (LIKELY(!(thiz_size < (int64_t)kObjectAlignment))
-                    && LIKELY(thiz_size < kValidObjectSize /** 1MB*/)) {
-                return true;
-            } else {
-                if (LIKELY(!(thiz_size < kValidObjectSize)))
-                    LOGD("This bad object (%lx) too large.\n", Ptr());
-                if (LIKELY(!!(thiz_size < (int64_t)kObjectAlignment)))
-                    LOGD("This bad object (%lx) too small.\n", Ptr());
-                return false;
-            }
-        }
-    } catch (InvalidAddressException e) {
-        // do nothing
+    if (LIKELY(!(thiz_size < (int64_t)kObjectAlignment))
+            && LIKELY(thiz_size < kValidObjectSize /** 1MB*/)) {
+        return true;
+    } else {
+        if (LIKELY(!(thiz_size < kValidObjectSize)))
+            LOGD("This bad object (%lx) too large.\n", Ptr());
+        if (LIKELY(!!(thiz_size < (int64_t)kObjectAlignment)))
+            LOGD("This bad object (%lx) too small.\n", Ptr());
+        return false;
     }
-    return false;
 }
 
 uint64_t Object::NextValidOffset(uint64_t max) {
@@ -82,6 +82,9 @@ public:
 private:
     // quick memoryref cache
     DEFINE_QUICK_CACHE(api::MemoryRef, klass);
+
+    // exception free SizeOf() of an object with a sane klass_, for validation.
+    bool TryValidSizeOf(int64_t* size);
 };
 
 } // namespace mirror
@@ -105,21 +105,28 @@ uint64_t NterpGetFrameDexPcPtr(QuickFrame& frame) {
     return dex_pc_ptr.valueOf();
 }
 
+uint64_t NterpGetReferenceArray(QuickFrame& frame) {
+    ArtMethod& method = frame.GetMethod();
+    art::dex::CodeItem item = method.GetCodeItem();
+    const uint16_t out_regs = item.out_regs_;
+    uint32_t pointer_size = CoreApi::GetPointSize();
+
+    // The references array is just above the saved frame pointer.
+    return frame.Ptr() +
+           pointer_size +
+           RoundUp(out_regs * kVRegSize, pointer_size) +
+           pointer_size +
+           pointer_size;
+}
+
 void NterpGetFrameVRegs(QuickFrame& frame) {
     std::map<uint32_t, DexRegisterInfo>& vregs = frame.GetVRegsCache();
     ArtMethod& method = frame.GetMethod();
     art::dex::CodeItem item = method.GetCodeItem();
     const uint16_t num_regs = item.num_regs_;
-    const uint16_t out_regs = item.out_regs_;
-    uint32_t pointer_size = CoreApi::GetPointSize();
 
-    api::MemoryRef dex_vregs_ptr(frame.Ptr() +
-                                 pointer_size +
-                                 RoundUp(out_regs * kVRegSize, pointer_size) +
-                                 pointer_size +
-                                 pointer_size +
-                                 (num_regs * kVRegSize),
-                                 frame);
+    // The registers array is just above the reference array.
+    api::MemoryRef dex_vregs_ptr(NterpGetReferenceArray(frame) + (num_regs * kVRegSize), frame);
 
     for (int i = 0; i < num_regs; ++i) {
         DexRegisterInfo info(DexRegisterInfo::Kind::kConstant,
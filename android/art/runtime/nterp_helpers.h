@@ -27,6 +27,7 @@ inline QuickMethodFrameInfo NterpFrameInfo(QuickFrame& frame) {
     return NterpFrameInfo(frame.GetMethod());
 }
 uint64_t NterpGetFrameDexPcPtr(QuickFrame& frame);
+uint64_t NterpGetReferenceArray(QuickFrame& frame);
 void NterpGetFrameVRegs(QuickFrame& frame);
 
 } // namespace art
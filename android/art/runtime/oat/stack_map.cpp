@@ -711,6 +711,39 @@ void CodeInfo::NativePc2VRegsV2(uint32_t native_pc, std::map<uint32_t, DexRegist
     }
 }
 
+void CodeInfo::NativePc2StackMask(uint32_t native_pc, std::vector<uint32_t>& slots) {
+    if (OatHeader::OatVersion() < 170)
+        return;
+
+    StackMap& map = GetStackMap();
+    if (!map.IsValid()) return;
+
+    // same row as NativePc2VRegsV2, the first one past the call.
+    uint32_t stack_mask_index = BitTable::kNoValue;
+    for (uint32_t row = 0; row < map.NumRows(); row++) {
+        uint32_t packed_native_pc = map.Get(row, StackMap::kColNumPackedNativePc);
+        uint32_t current_native_pc = StackMap::UnpackNativePc(packed_native_pc);
+        stack_mask_index = map.Get(row, StackMap::kColNumStackMaskIndex);
+        if (current_native_pc > native_pc)
+            break;
+    }
+
+    if (stack_mask_index == BitTable::kNoValue) return;
+    StackMask& stack_mask = GetStackMask();
+    if (!stack_mask.IsValid() || stack_mask_index >= stack_mask.NumRows()) return;
+
+    BitMemoryRegion mask = stack_mask.GetBitMemoryRegion(stack_mask_index, StackMask::kColNumMask);
+    uint32_t end = mask.size_in_bits();
+    for (uint32_t slot = 0; slot < end; slot += 32) {
+        uint32_t bits = mask.LoadBits(slot, std::min<uint32_t>(end - slot, 32));
+        while (bits != 0) {
+            uint32_t bit = __builtin_ctz(bits);
+            slots.push_back(slot + bit);
+            bits &= bits - 1;
+        }
+    }
+}
+
 std::string DexRegisterInfo::ConvertKindBit(DexRegisterInfo::KindBit kind) {
     switch(kind) {
         case DexRegisterInfo::KindBit::kInStack: return "stack";
@@ -493,6 +493,8 @@ public:
     uint32_t NativePc2DexPc(uint32_t native_pc);
     void NativePc2VRegs(uint32_t native_pc, std::map<uint32_t, DexRegisterInfo>& vregs);
     void NativeStackMaps(std::vector<GeneralStackMap>& maps);
+    // stack slots (in kFrameSlotSize units from sp) holding live references.
+    void NativePc2StackMask(uint32_t native_pc, std::vector<uint32_t>& slots);
     void ExtendNumRegister(ArtMethod& method);
 
     void Dump(const char* prefix);
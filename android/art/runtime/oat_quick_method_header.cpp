@@ -208,6 +208,11 @@ void OatQuickMethodHeader::NativeStackMaps(std::vector<GeneralStackMap>& maps) {
     code_info.NativeStackMaps(maps);
 }
 
+void OatQuickMethodHeader::NativePc2StackMask(uint32_t native_pc, std::vector<uint32_t>& slots) {
+    CodeInfo code_info = CodeInfo::Decode(GetOptimizedCodeInfoPtr());
+    code_info.NativePc2StackMask(native_pc, slots);
+}
+
 void OatQuickMethodHeader::Dump(const char* prefix) {
     LOGI("%sOatQuickMethodHeader(0x%lx)\n", prefix, Ptr());
     LOGI("%s  code_offset: 0x%lx\n", prefix, GetCodeStart());
@@ -96,6 +96,7 @@ public:
     uint32_t NativePc2DexPc(uint32_t native_pc);
     void NativePc2VRegs(uint32_t native_pc, std::map<uint32_t, DexRegisterInfo>& vregs);
     void NativeStackMaps(std::vector<GeneralStackMap>& maps);
+    void NativePc2StackMask(uint32_t native_pc, std::vector<uint32_t>& slots);
     void Dump(const char* prefix);
 private:
     // quick memoryref cache
@@ -470,8 +470,9 @@ ArtMethod& Runtime::GetCalleeSaveMethod(CalleeSaveType type) {
 
 ArtMethod& Runtime::GetCalleeSaveMethodUnchecked(CalleeSaveType type) {
     uint32_t index = static_cast<uint32_t>(type);
-    if (!callee_save_methods_cache[index].Ptr()) {
-        memset(callee_save_methods_cache, 0x0, sizeof(callee_save_methods_cache));
+    // types past kNumCalleeMethodsCount stay empty, refilling rewrites the
+    // same values so concurrent stack walkers never see a cleared entry.
+    if (index < kNumCalleeMethodsCount && !callee_save_methods_cache[index].Ptr()) {
         api::MemoryRef ref = callee_save_methods();
         for (uint32_t i = 0; i < kNumCalleeMethodsCount; ++i) {
             callee_save_methods_cache[i] = ref.value64Of(i * sizeof(uint64_t));
@@ -25,6 +25,7 @@
 #include "runtime/base/callee_save_type.h"
 #include "runtime/entrypoints/quick/callee_save_frame.h"
 #include "runtime/oat/stack_map.h"
+#include "runtime/oat.h"
 
 namespace art {
 
@@ -66,6 +67,50 @@ ArtMethod StackVisitor::GetTopMethod() {
     return GetMethod();
 }
 
+void StackVisitor::PrepareParallelWalk() {
+    try {
+        Runtime& runtime = Runtime::Current();
+        if (!runtime.Ptr())
+            return;
+
+        runtime.GetClassLinker();
+        runtime.GetResolutionMethod();
+        runtime.GetImtConflictMethod();
+        runtime.GetImtUnimplementedMethod();
+        runtime.GetCalleeSaveMethod(CalleeSaveType::kSaveAllCalleeSaves);
+        OatHeader::OatVersion();
+
+        CacheHelper::JniDlsymLookupStub();
+        CacheHelper::JniDlsymLookupCriticalStub();
+        CacheHelper::QuickImtConflictStub();
+        CacheHelper::QuickToInterpreterBridge();
+        CacheHelper::InvokeObsoleteMethodStub();
+        CacheHelper::QuickGenericJniStub();
+        CacheHelper::QuickProxyInvokeHandler();
+        CacheHelper::QuickResolutionStub();
+        CacheHelper::QuickDeoptimizationEntryPoint();
+        CacheHelper::NterpWithClinitImpl();
+        CacheHelper::NterpImpl();
+        CacheHelper::NterpMethodHeader();
+
+        jit::Jit& jit = runtime.GetJit();
+        if (!jit.Ptr())
+            return;
+        jit::JitCodeCache& code_cache = jit.GetCodeCache();
+        if (!code_cache.Ptr())
+            return;
+        // walks every region of this sdk once.
+        code_cache.ContainsPc(0x0);
+        if (Android::Sdk() >= Android::P)
+            code_cache.GetJniStubsMap();
+        if (Android::Sdk() >= Android::R)
+            code_cache.GetZygoteMap();
+        code_cache.GetMethodCodes();
+    } catch(InvalidAddressException e) {
+        LOGD("Prepare stack walk caches fail.\n");
+    }
+}
+
 void StackVisitor::WalkStack() {
     bool first_stack = true;
     java_frames_.clear();
@@ -83,6 +83,11 @@ public:
     };
 
     StackVisitor(Thread* thread, StackWalkKind kind) : thread_(thread), walk_kind_(kind) {}
+    /*
+     * WalkStack fills runtime, jit and entry point caches on first use and
+     * none of them are locked, call this once before walking stacks in parallel.
+     */
+    static void PrepareParallelWalk();
     std::vector<std::unique_ptr<JavaFrame>>& GetJavaFrames() { return java_frames_; }
     Thread* GetThread() { return thread_; }
     void WalkStack();
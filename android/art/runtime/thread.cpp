@@ -200,6 +200,7 @@ void Thread::tls_ptr_sized_values::Init26() {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 16,
             .managed_stack = 24,
+            .jni_env = 56,
             .self = 72,
             .opeer = 80,
             .stack_begin = 96,
@@ -207,12 +208,16 @@ void Thread::tls_ptr_sized_values::Init26() {
             .monitor_enter_object = 128,
             .name = 208,
             .pthread_self = 216,
+            .thread_local_start = 264,
+            .thread_local_pos = 272,
+            .thread_local_end = 280,
             .held_mutexes = 1768,
         };
     } else {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 8,
             .managed_stack = 12,
+            .jni_env = 28,
             .self = 36,
             .opeer = 40,
             .stack_begin = 48,
@@ -220,6 +225,9 @@ void Thread::tls_ptr_sized_values::Init26() {
             .monitor_enter_object = 64,
             .name = 104,
             .pthread_self = 108,
+            .thread_local_start = 132,
+            .thread_local_pos = 136,
+            .thread_local_end = 140,
             .held_mutexes = 884,
         };
     }
@@ -230,6 +238,7 @@ void Thread::tls_ptr_sized_values::Init28() {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 16,
             .managed_stack = 24,
+            .jni_env = 56,
             .self = 72,
             .opeer = 80,
             .stack_begin = 96,
@@ -237,12 +246,16 @@ void Thread::tls_ptr_sized_values::Init28() {
             .monitor_enter_object = 128,
             .name = 208,
             .pthread_self = 216,
+            .thread_local_start = 264,
+            .thread_local_pos = 272,
+            .thread_local_end = 280,
             .held_mutexes = 1776,
         };
     } else {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 8,
             .managed_stack = 12,
+            .jni_env = 28,
             .self = 36,
             .opeer = 40,
             .stack_begin = 48,
@@ -250,6 +263,9 @@ void Thread::tls_ptr_sized_values::Init28() {
             .monitor_enter_object = 64,
             .name = 104,
             .pthread_self = 108,
+            .thread_local_start = 132,
+            .thread_local_pos = 136,
+            .thread_local_end = 140,
             .held_mutexes = 888,
         };
     }
@@ -260,6 +276,7 @@ void Thread::tls_ptr_sized_values::Init29() {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 16,
             .managed_stack = 24,
+            .jni_env = 56,
             .self = 72,
             .opeer = 80,
             .stack_begin = 96,
@@ -267,12 +284,16 @@ void Thread::tls_ptr_sized_values::Init29() {
             .monitor_enter_object = 128,
             .name = 208,
             .pthread_self = 216,
+            .thread_local_start = 264,
+            .thread_local_pos = 272,
+            .thread_local_end = 280,
             .held_mutexes = 1792,
         };
     } else {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 8,
             .managed_stack = 12,
+            .jni_env = 28,
             .self = 36,
             .opeer = 40,
             .stack_begin = 48,
@@ -280,6 +301,9 @@ void Thread::tls_ptr_sized_values::Init29() {
             .monitor_enter_object = 64,
             .name = 104,
             .pthread_self = 108,
+            .thread_local_start = 132,
+            .thread_local_pos = 136,
+            .thread_local_end = 140,
             .held_mutexes = 896,
         };
     }
@@ -290,6 +314,7 @@ void Thread::tls_ptr_sized_values::Init30() {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 16,
             .managed_stack = 24,
+            .jni_env = 56,
             .self = 72,
             .opeer = 80,
             .stack_begin = 96,
@@ -297,12 +322,16 @@ void Thread::tls_ptr_sized_values::Init30() {
             .monitor_enter_object = 128,
             .name = 192,
             .pthread_self = 200,
+            .thread_local_start = 248,
+            .thread_local_pos = 256,
+            .thread_local_end = 264,
             .held_mutexes = 1808,
         };
     } else {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 8,
             .managed_stack = 12,
+            .jni_env = 28,
             .self = 36,
             .opeer = 40,
             .stack_begin = 48,
@@ -310,6 +339,9 @@ void Thread::tls_ptr_sized_values::Init30() {
             .monitor_enter_object = 64,
             .name = 96,
             .pthread_self = 100,
+            .thread_local_start = 124,
+            .thread_local_pos = 128,
+            .thread_local_end = 132,
             .held_mutexes = 904,
         };
     }
@@ -320,6 +352,7 @@ void Thread::tls_ptr_sized_values::Init33() {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 16,
             .managed_stack = 24,
+            .jni_env = 56,
             .self = 72,
             .opeer = 80,
             .stack_begin = 96,
@@ -327,12 +360,16 @@ void Thread::tls_ptr_sized_values::Init33() {
             .monitor_enter_object = 128,
             .name = 192,
             .pthread_self = 200,
+            .thread_local_start = 248,
+            .thread_local_pos = 256,
+            .thread_local_end = 264,
             .held_mutexes = 1792,
         };
     } else {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 8,
             .managed_stack = 12,
+            .jni_env = 28,
             .self = 36,
             .opeer = 40,
             .stack_begin = 48,
@@ -340,6 +377,9 @@ void Thread::tls_ptr_sized_values::Init33() {
             .monitor_enter_object = 64,
             .name = 96,
             .pthread_self = 100,
+            .thread_local_start = 124,
+            .thread_local_pos = 128,
+            .thread_local_end = 132,
             .held_mutexes = 896,
         };
     }
@@ -350,6 +390,7 @@ void Thread::tls_ptr_sized_values::Init34() {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 16,
             .managed_stack = 24,
+            .jni_env = 56,
             .self = 72,
             .opeer = 80,
             .stack_begin = 96,
@@ -357,12 +398,16 @@ void Thread::tls_ptr_sized_values::Init34() {
             .monitor_enter_object = 128,
             .name = 184,
             .pthread_self = 192,
+            .thread_local_start = 232,
+            .thread_local_pos = 240,
+            .thread_local_end = 248,
             .held_mutexes = 1808,
         };
     } else {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 8,
             .managed_stack = 12,
+            .jni_env = 28,
             .self = 36,
             .opeer = 40,
             .stack_begin = 48,
@@ -370,6 +415,9 @@ void Thread::tls_ptr_sized_values::Init34() {
             .monitor_enter_object = 64,
             .name = 92,
             .pthread_self = 96,
+            .thread_local_start = 116,
+            .thread_local_pos = 120,
+            .thread_local_end = 124,
             .held_mutexes = 904,
         };
     }
@@ -380,6 +428,7 @@ void Thread::tls_ptr_sized_values::Init35() {
         __Thread_tls_ptr_sized_values_offset__ = {
             .stack_end = 16,
             .managed_stack = 24,
+            .jni_env = 56,
             .self = 72,
             .opeer = 80,
             .stack_begin = 96,
@@ -387,6 +436,9 @@ void Thread::tls_ptr_sized_values::Init35() {
             .monitor_enter_object = 128,
             .name = 184,
             .pthread_self = 192,
+            .thread_local_start = 232,
+            .thread_local_pos = 240,
+            .thread_local_end = 248,
             .held_mutexes = 1800,
         };
     }
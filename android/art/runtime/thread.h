@@ -53,6 +53,7 @@ extern struct Thread_tls_32bit_sized_values_SizeTable __Thread_tls_32bit_sized_v
 struct Thread_tls_ptr_sized_values_OffsetTable {
     uint32_t stack_end;
     uint32_t managed_stack;
+    uint32_t jni_env;
     uint32_t self;
     uint32_t opeer;
     uint32_t stack_begin;
@@ -60,6 +61,9 @@ struct Thread_tls_ptr_sized_values_OffsetTable {
     uint32_t monitor_enter_object;
     uint32_t name;
     uint32_t pthread_self;
+    uint32_t thread_local_start;
+    uint32_t thread_local_pos;
+    uint32_t thread_local_end;
     uint32_t held_mutexes;
 };
 
@@ -127,6 +131,7 @@ public:
         static void Init35();
         inline uint64_t stack_end() { return VALUEOF(Thread_tls_ptr_sized_values, stack_end); }
         inline uint64_t managed_stack() { return Ptr() + OFFSET(Thread_tls_ptr_sized_values, managed_stack); }
+        inline uint64_t jni_env() { return VALUEOF(Thread_tls_ptr_sized_values, jni_env); }
         inline uint64_t self() { return VALUEOF(Thread_tls_ptr_sized_values, self); }
         inline uint64_t opeer() { return VALUEOF(Thread_tls_ptr_sized_values, opeer); }
         inline uint64_t stack_begin() { return VALUEOF(Thread_tls_ptr_sized_values, stack_begin); }
@@ -134,6 +139,9 @@ public:
         inline uint64_t monitor_enter_object() { return VALUEOF(Thread_tls_ptr_sized_values, monitor_enter_object); }
         inline uint64_t name() { return VALUEOF(Thread_tls_ptr_sized_values, name); }
         inline uint64_t pthread_self() { return VALUEOF(Thread_tls_ptr_sized_values, pthread_self); }
+        inline uint64_t thread_local_start() { return VALUEOF(Thread_tls_ptr_sized_values, thread_local_start); }
+        inline uint64_t thread_local_pos() { return VALUEOF(Thread_tls_ptr_sized_values, thread_local_pos); }
+        inline uint64_t thread_local_end() { return VALUEOF(Thread_tls_ptr_sized_values, thread_local_end); }
         inline uint64_t held_mutexes() { return Ptr() + OFFSET(Thread_tls_ptr_sized_values, held_mutexes); }
     };
 
@@ -27,14 +27,19 @@
 #include "common/exception.h"
 #include "base/utils.h"
 #include "base/macros.h"
+#include "zip/compressor.h"
+#include "zip/decompressor.h"
 #include <linux/elf.h>
 #include <cstring>
+#include <algorithm>
 #include <iomanip>
 #include <filesystem>
 #include <iostream>
 
 std::unique_ptr<CoreApi> CoreApi::INSTANCE = nullptr;
 bool CoreApi::QUICK_LOAD_ENABLED = true;
+thread_local CoreApi::Tlb CoreApi::sTlb;
+std::atomic<uint64_t> CoreApi::sBlockTableGeneration = 0;
 
 void CoreApi::Init() {
     api::Elf::Init();
@@ -50,7 +55,9 @@ bool CoreApi::Load(const char* corefile, std::function<void ()> callback) {
 }
 
 bool CoreApi::Load(const char* corefile, bool remote, std::function<void ()> callback) {
-    std::unique_ptr<MemoryMap> map(MemoryMap::MmapFile(corefile));
+    std::unique_ptr<MemoryMap> map(Decompressor::TypeOf(corefile) != Compressor::TYPE_NONE
+                                   ? MemoryMap::MmapCompressedFile(corefile)
+                                   : MemoryMap::MmapFile(corefile));
     return Load(map, remote, callback);
 }
 
@@ -149,8 +156,8 @@ uint64_t CoreApi::NewLoadBlock(uint64_t vaddr, uint64_t size) {
 }
 
 uint64_t CoreApi::newLoadBlock(uint64_t vaddr, uint64_t old_size) {
-    int idxInLoad = 0;
-    int idxInQuick = 0;
+    size_t idxInLoad = 0;
+    size_t idxInQuick = 0;
 
     uint64_t begin = RoundUp(vaddr & getVabitsMask(), ELF_PAGE_SIZE);
     uint64_t size = RoundUp(old_size, ELF_PAGE_SIZE);
@@ -196,7 +203,7 @@ uint64_t CoreApi::newLoadBlock(uint64_t vaddr, uint64_t old_size) {
             if (FAKE_LOAD_BEGIN + size <= left->vaddr()) {
                 begin = FAKE_LOAD_BEGIN;
             } else {
-                for (int idx = 1; idx < mLoad.size(); ++idx) {
+                for (size_t idx = 1; idx < mLoad.size(); ++idx) {
                     std::shared_ptr<LoadBlock> right = mLoad[idx];
                     if (right->vaddr() - (left->vaddr() + left->size()) >= size) {
                         idxInLoad = idx;
@@ -236,6 +243,7 @@ uint64_t CoreApi::newLoadBlock(uint64_t vaddr, uint64_t old_size) {
 
     mLoad.insert(mLoad.begin() + idxInLoad, block);
     mQuickLoad.insert(mQuickLoad.begin() + idxInQuick, block);
+    invalidBlockTable();
     return begin;
 }
 
@@ -243,11 +251,81 @@ void CoreApi::addLoadBlock(std::shared_ptr<LoadBlock>& block) {
     mLoad.push_back(block);
     if (!QUICK_LOAD_ENABLED || block->flags())
         mQuickLoad.push_back(block);
+    invalidBlockTable();
 }
 
 void CoreApi::removeAllLoadBlock() {
     mQuickLoad.clear();
     mLoad.clear();
+    invalidBlockTable();
+}
+
+void CoreApi::BlockTable::build(std::vector<std::shared_ptr<LoadBlock>>& loads) {
+    begins.resize(loads.size());
+    ends.resize(loads.size());
+    blocks.resize(loads.size());
+    for (size_t i = 0; i < loads.size(); ++i) {
+        begins[i] = loads[i]->vaddr();
+        ends[i] = loads[i]->vaddr() + loads[i]->size();
+        blocks[i] = loads[i].get();
+    }
+}
+
+void CoreApi::BlockTable::buildReal(std::vector<std::shared_ptr<LoadBlock>>& loads) {
+    std::vector<std::pair<uint64_t, size_t>> ranges;
+    for (size_t i = 0; i < loads.size(); ++i) {
+        LoadBlock* block = loads[i].get();
+        if (block->begin(Block::OPT_READ_OR))
+            ranges.push_back({block->begin(Block::OPT_READ_OR), i});
+        if (block->begin(Block::OPT_READ_MMAP))
+            ranges.push_back({block->begin(Block::OPT_READ_MMAP), i});
+        if (block->begin(Block::OPT_READ_OVERLAY))
+            ranges.push_back({block->begin(Block::OPT_READ_OVERLAY), i});
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    begins.resize(ranges.size());
+    ends.resize(ranges.size());
+    blocks.resize(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        LoadBlock* block = loads[ranges[i].second].get();
+        begins[i] = ranges[i].first;
+        // only file backed bytes of the core are mapped.
+        ends[i] = begins[i] + (begins[i] == block->oraddr() ? block->realSize() : block->size());
+        blocks[i] = block;
+    }
+}
+
+int CoreApi::BlockTable::find(uint64_t clocaddr) {
+    // last block begin <= clocaddr
+    auto it = std::upper_bound(begins.begin(), begins.end(), clocaddr);
+    if (it == begins.begin())
+        return -1;
+
+    int idx = (it - begins.begin()) - 1;
+    if (clocaddr >= ends[idx])
+        return -1;
+    return idx;
+}
+
+void CoreApi::buildBlockTable() {
+    std::lock_guard<std::mutex> guard(mBlockTableLock);
+    if (mBlockTableReady.load(std::memory_order_relaxed))
+        return;
+
+    mLoadTable.build(mLoad);
+    mQuickTable.build(mQuickLoad);
+    mBlockTableEpoch = ++sBlockTableGeneration;
+    mBlockTableReady.store(true, std::memory_order_release);
+}
+
+void CoreApi::buildRealTable() {
+    std::lock_guard<std::mutex> guard(mBlockTableLock);
+    if (mRealTableReady.load(std::memory_order_relaxed))
+        return;
+
+    mRealTable.buildReal(mLoad);
+    mRealTableReady.store(true, std::memory_order_release);
 }
 
 void CoreApi::removeAllBindMap() {
@@ -282,10 +360,46 @@ void CoreApi::addLinkMap(uint64_t map) {
 }
 
 void CoreApi::removeAllLinkMap() {
+    removeAllSymbolIndex();
     removeAllBindMap();
     mLinkMap.clear();
 }
 
+void CoreApi::removeAllSymbolIndex() {
+    std::lock_guard<std::mutex> guard(mSymbolIndexLock);
+    mSymbolIndex.clear();
+    mSymbolIndexReady.store(false, std::memory_order_release);
+}
+
+void CoreApi::buildSymbolIndex() {
+    std::lock_guard<std::mutex> guard(mSymbolIndexLock);
+    if (mSymbolIndexReady.load(std::memory_order_relaxed))
+        return;
+
+    auto callback = [&](LinkMap* map) -> bool {
+        if (!map->block())
+            return false;
+        for (const auto& entry : map->GetSymbolNames()) {
+            if (entry.second->offset)
+                mSymbolIndex.insert(std::pair<std::string_view, LinkMap*>(entry.first, map));
+        }
+        return false;
+    };
+    foreachLinkMap(callback);
+    mSymbolIndexReady.store(true, std::memory_order_release);
+    LOGD("Symbol index[%ld]\n", mSymbolIndex.size());
+}
+
+LinkMap* CoreApi::findSymbolLinkMap(const char* symbol) {
+    if (!mSymbolIndexReady.load(std::memory_order_acquire))
+        buildSymbolIndex();
+
+    const auto& it = mSymbolIndex.find(symbol);
+    if (it != mSymbolIndex.end())
+        return it->second;
+    return nullptr;
+}
+
 void CoreApi::Dump() {
     LOGI(ANSI_COLOR_LIGHTRED "Core env:\n" ANSI_COLOR_RESET);
     LOGI("  * Path: " ANSI_COLOR_LIGHTGREEN "%s\n" ANSI_COLOR_RESET, GetName());
@@ -307,18 +421,12 @@ void CoreApi::ForeachFile(std::function<bool (File *)> callback) {
 }
 
 File* CoreApi::FindFile(uint64_t vaddr) {
-    File *result = nullptr;
-    if (!vaddr) return result;
-    uint64_t clocvaddr = vaddr & GetVabitsMask();
-    auto callback = [&](File* file) -> bool {
-        if (file->contains(clocvaddr)) {
-            result = file;
-            return true;
-        }
-        return false;
-    };
-    INSTANCE->foreachFile(callback);
-    return result;
+    if (!vaddr) return nullptr;
+    return INSTANCE->findFile(vaddr & GetVabitsMask());
+}
+
+std::vector<File*>* CoreApi::FindFiles(const char* name) {
+    return INSTANCE->findFiles(name);
 }
 
 LinkMap* CoreApi::FindLinkMap(const char* path) {
@@ -443,20 +551,12 @@ void CoreApi::ForeachLoadBlock(std::function<bool (LoadBlock *)> callback, bool
 }
 
 uint64_t CoreApi::DlSym(const char* symbol) {
-    uint64_t value;
-    auto callback = [&](LinkMap* map) -> bool {
-        LoadBlock* block = map->block();
-        if (block) {
-            value = map->DlSym(symbol);
-            if (value) {
-                value += map->l_addr();
-                return true;
-            }
-        }
-        return false;
-    };
-    INSTANCE->foreachLinkMap(callback);
-    return value;
+    LinkMap* map = INSTANCE->findSymbolLinkMap(symbol);
+    if (map) {
+        uint64_t value = map->DlSym(symbol);
+        if (value) return value + map->l_addr();
+    }
+    return 0x0;
 }
 
 uint64_t CoreApi::DlSym(const char* path, const char* symbol) {
@@ -489,11 +589,13 @@ uint64_t CoreApi::v2r(uint64_t vaddr, int opt) {
 }
 
 uint64_t CoreApi::r2v(uint64_t raddr) {
-    for (const auto& block : mQuickLoad) {
-        if (block->realContains(raddr))
-            return block->vaddr() + (raddr - block->begin());
-    }
-    throw InvalidAddressException(raddr);
+    if (!mRealTableReady.load(std::memory_order_acquire))
+        buildRealTable();
+
+    int idx = mRealTable.find(raddr);
+    if (idx < 0)
+        throw InvalidAddressException(raddr);
+    return mRealTable.blocks[idx]->vaddr() + (raddr - mRealTable.begins[idx]);
 }
 
 bool CoreApi::virtualValid(uint64_t vaddr) {
@@ -506,9 +608,65 @@ void CoreApi::addNoteBlock(std::unique_ptr<NoteBlock>& block) {
 }
 
 void CoreApi::removeAllNoteBlock() {
+    mFileTableReady.store(false, std::memory_order_release);
+    mFileTable = FileTable();
     mNote.clear();
 }
 
+void CoreApi::FileTable::build(std::vector<std::unique_ptr<NoteBlock>>& notes) {
+    files.clear();
+    names.clear();
+    for (const auto& block : notes) {
+        for (const auto& file : block->getFile())
+            files.push_back(file.get());
+    }
+    std::stable_sort(files.begin(), files.end(), [](File* a, File* b) {
+        return a->begin() < b->begin();
+    });
+
+    begins.resize(files.size());
+    max_ends.resize(files.size());
+    uint64_t max_end = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        begins[i] = files[i]->begin();
+        max_end = std::max(max_end, files[i]->end());
+        max_ends[i] = max_end;
+        names[files[i]->name()].push_back(files[i]);
+    }
+}
+
+File* CoreApi::FileTable::find(uint64_t clocaddr) {
+    // last file begin <= clocaddr, walk back while an earlier file may still cover it.
+    auto it = std::upper_bound(begins.begin(), begins.end(), clocaddr);
+    for (int idx = (it - begins.begin()) - 1; idx >= 0 && max_ends[idx] > clocaddr; --idx) {
+        if (files[idx]->contains(clocaddr))
+            return files[idx];
+    }
+    return nullptr;
+}
+
+void CoreApi::buildFileTable() {
+    std::lock_guard<std::mutex> guard(mBlockTableLock);
+    if (mFileTableReady.load(std::memory_order_relaxed))
+        return;
+
+    mFileTable.build(mNote);
+    mFileTableReady.store(true, std::memory_order_release);
+}
+
+File* CoreApi::findFile(uint64_t clocaddr) {
+    if (!mFileTableReady.load(std::memory_order_acquire))
+        buildFileTable();
+    return mFileTable.find(clocaddr);
+}
+
+std::vector<File*>* CoreApi::findFiles(const char* name) {
+    if (!mFileTableReady.load(std::memory_order_acquire))
+        buildFileTable();
+    auto it = mFileTable.names.find(name);
+    return it != mFileTable.names.end() ? &it->second : nullptr;
+}
+
 uint64_t CoreApi::findAuxv(uint64_t type) {
     for (const auto& block : mNote) {
         for (const auto& auxv : block->getAuxv()) {
@@ -30,7 +30,11 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <map>
+#include <mutex>
+#include <atomic>
 
 /*
              ---------- <-
@@ -106,6 +110,7 @@ public:
     static uint64_t GetVabitsMask();
     static uint64_t GetPageSize() { return INSTANCE->getPageSize(); }
     static bool IsRemote() { return IsReady() && INSTANCE->isRemote(); }
+    static MemoryMap* GetCoreMap() { return INSTANCE ? INSTANCE->mCore.get() : nullptr; }
     static std::vector<std::shared_ptr<LoadBlock>>& GetLoads(bool quick) {
         return INSTANCE->getLoads(quick);
     }
@@ -126,10 +131,14 @@ public:
     static void Init();
     static void Dump();
     static void CleanCache();
+    static void CleanSymbolIndex() { if (INSTANCE) INSTANCE->removeAllSymbolIndex(); }
+    static void CleanRealTable() { if (INSTANCE) INSTANCE->invalidRealTable(); }
     static void ForeachFile(std::function<bool (File *)> callback);
     static void ForeachAuxv(std::function<bool (Auxv *)> callback);
     static void ForeachLinkMap(std::function<bool (LinkMap *)> callback);
     static File* FindFile(uint64_t vaddr);
+    // every NT_FILE mapping of the file, sorted by begin, nullptr if none.
+    static std::vector<File*>* FindFiles(const char* name);
     static LinkMap* FindLinkMap(const char* path);
     static void ExecFile(const char* file);
     static void SysRoot(const char* dir);
@@ -197,30 +206,42 @@ public:
      *  M0 S1 < E1 <= M1 < S2 <= M2 < E2 <= M3 ...
      */
     inline LoadBlock* findLoadBlock(uint64_t vaddr, bool quick) {
-        std::vector<std::shared_ptr<LoadBlock>>& loads = getLoads(quick);
-        if (loads.empty()) return nullptr;
+        if (!mBlockTableReady.load(std::memory_order_acquire))
+            buildBlockTable();
 
-        int left = 0;
-        int right = loads.size();
         uint64_t clocaddr = vaddr & getVabitsMask();
+        Tlb& tlb = sTlb;
+        if (tlb.epoch != mBlockTableEpoch) {
+            tlb = Tlb();
+            tlb.epoch = mBlockTableEpoch;
+        }
 
-        if (clocaddr < loads[left]->vaddr()
-                || clocaddr >= (loads[right - 1]->vaddr() + loads[right - 1]->size()))
-           return nullptr;
+        TlbEntry& entry = tlb.entries[quick][(clocaddr >> TLB_PAGE_SHIFT) & (TLB_SIZE - 1)];
+        if (clocaddr >= entry.begin && clocaddr < entry.end)
+            return entry.block;
 
-        while (left < right) {
-            int mid = left + (right - left) / 2;
-            LoadBlock* block = loads[mid].get();
-            if (block->vaddr() > clocaddr) {
-                right = mid;
-            } else {
-                if (clocaddr < (block->vaddr() + block->size()))
-                    return block;
-                left = mid + 1;
-            }
-        }
-        return nullptr;
+        BlockTable& table = quick ? mQuickTable : mLoadTable;
+        int idx = table.find(clocaddr);
+        if (idx < 0) return nullptr;
+
+        entry.begin = table.begins[idx];
+        entry.end = table.ends[idx];
+        entry.block = table.blocks[idx];
+        return entry.block;
+    }
+    /*
+     * Must be called after mLoad or mQuickLoad changed, mmap/overlay of a block
+     * keep its range and pointer so they need no invalidation.
+     */
+    inline void invalidBlockTable() {
+        mBlockTableReady.store(false, std::memory_order_release);
+        invalidRealTable();
     }
+    /*
+     * Must be called after any original, mmap or overlay backing of a
+     * block changed.
+     */
+    inline void invalidRealTable() { mRealTableReady.store(false, std::memory_order_release); }
     void removeAllLoadBlock();
     void removeAllBindMap();
     inline uint64_t v2r(uint64_t vaddr, int opt);
@@ -228,10 +249,19 @@ public:
     inline bool virtualValid(uint64_t vaddr);
     void addNoteBlock(std::unique_ptr<NoteBlock>& block);
     void removeAllNoteBlock();
+    /*
+     * Must be called after all note blocks were added, otherwise the first
+     * file query builds it.
+     */
+    void buildFileTable();
+    File* findFile(uint64_t clocaddr);
+    std::vector<File*>* findFiles(const char* name);
     uint64_t findAuxv(uint64_t type);
     ThreadApi* findThread(int tid);
     void addLinkMap(uint64_t map);
     void removeAllLinkMap();
+    void removeAllSymbolIndex();
+    LinkMap* findSymbolLinkMap(const char* symbol);
     void foreachThread(std::function<bool (ThreadApi *)> callback);
     void foreachFile(std::function<bool (File *)> callback);
     void foreachAuxv(std::function<bool (Auxv *)> callback);
@@ -252,6 +282,58 @@ protected:
     uint64_t vabits_mask;
     uint64_t page_size;
 private:
+    /*
+     * Structure-of-arrays copy of a sorted load list, begins is searched
+     * without touching the LoadBlock objects.
+     */
+    class BlockTable {
+    public:
+        std::vector<uint64_t> begins;
+        std::vector<uint64_t> ends;
+        std::vector<LoadBlock*> blocks;
+        void build(std::vector<std::shared_ptr<LoadBlock>>& loads);
+        void buildReal(std::vector<std::shared_ptr<LoadBlock>>& loads);
+        int find(uint64_t clocaddr);
+    };
+
+    /*
+     * Per thread cache of recent translations, entries of an older table
+     * epoch are dropped on first use.
+     */
+    static constexpr int TLB_SIZE = 64;
+    static constexpr int TLB_PAGE_SHIFT = 12;
+    class TlbEntry {
+    public:
+        uint64_t begin = 0;
+        uint64_t end = 0;
+        LoadBlock* block = nullptr;
+    };
+    class Tlb {
+    public:
+        uint64_t epoch = 0;
+        TlbEntry entries[2][TLB_SIZE];
+    };
+    static thread_local Tlb sTlb;
+
+    /*
+     * NT_FILE entries sorted by begin, max_ends[i] is the largest end of
+     * entries [0, i] so nested or overlapping mappings are still found,
+     * names are keyed by the first File carrying them.
+     */
+    class FileTable {
+    public:
+        std::vector<File*> files;
+        std::vector<uint64_t> begins;
+        std::vector<uint64_t> max_ends;
+        std::unordered_map<std::string_view, std::vector<File*>> names;
+        void build(std::vector<std::unique_ptr<NoteBlock>>& notes);
+        File* find(uint64_t clocaddr);
+    };
+    static std::atomic<uint64_t> sBlockTableGeneration;
+    void buildBlockTable();
+    void buildRealTable();
+    void buildSymbolIndex();
+
     static std::unique_ptr<CoreApi> INSTANCE;
     virtual bool load() = 0;
     virtual void unload() = 0;
@@ -271,7 +353,27 @@ private:
     std::vector<std::unique_ptr<NoteBlock>> mNote;
     std::vector<std::unique_ptr<LinkMap>> mLinkMap;
     std::function<void (LinkMap *)> mSysRootCallback;
+    /*
+     * symbol name -> first LinkMap defined it, keys point into LinkMap symbols,
+     * must be cleaned whenever LinkMap or its symbols changed.
+     */
+    std::unordered_map<std::string_view, LinkMap*> mSymbolIndex;
+    std::atomic<bool> mSymbolIndexReady = false;
+    std::mutex mSymbolIndexLock;
     bool mRemote = false;
+    BlockTable mLoadTable;
+    BlockTable mQuickTable;
+    uint64_t mBlockTableEpoch = 0;
+    std::atomic<bool> mBlockTableReady = false;
+    std::mutex mBlockTableLock;
+    /*
+     * Host address ranges of every backing of every block, sorted by begin,
+     * begins[i] maps to blocks[i]->vaddr().
+     */
+    BlockTable mRealTable;
+    std::atomic<bool> mRealTableReady = false;
+    FileTable mFileTable;
+    std::atomic<bool> mFileTableReady = false;
 };
 
 #endif // CORE_API_CORE_H_
@@ -96,6 +96,18 @@ public:
 
         return block->begin() + ((vaddr & block->VabitsMask()) - block->vaddr());
     }
+    /*
+     * Non-throwing Real(), for hot loops walking memory which may be
+     * corrupted or not dumped, false instead of InvalidAddressException.
+     */
+    inline bool TryReal(uint64_t* real) {
+        Prepare(false);
+        if (!block || !block->isValid())
+            return false;
+
+        *real = block->begin() + ((vaddr & block->VabitsMask()) - block->vaddr());
+        return true;
+    }
     inline LoadBlock* Block() { return block; }
     inline uint64_t PointMask() { return block->PointMask(); }
     inline bool IsReady() { return block != nullptr; }
@@ -141,7 +153,27 @@ public:
     inline uint32_t value8Of(uint64_t offset) {
         return *reinterpret_cast<uint8_t *>(Real() + offset);
     }
+    inline bool TryValueOf(uint64_t* value) { return TryValueOf(0, value); }
+    inline bool TryValueOf(uint64_t offset, uint64_t* value) {
+        if (!TryRead(offset, value))
+            return false;
+        *value &= PointMask();
+        return true;
+    }
+    inline bool TryValue64Of(uint64_t offset, uint64_t* value) { return TryRead(offset, value); }
+    inline bool TryValue32Of(uint64_t offset, uint32_t* value) { return TryRead(offset, value); }
+    inline bool TryValue16Of(uint64_t offset, uint16_t* value) { return TryRead(offset, value); }
+    inline bool TryValue8Of(uint64_t offset, uint8_t* value) { return TryRead(offset, value); }
 private:
+    template<typename T>
+    inline bool TryRead(uint64_t offset, T* value) {
+        uint64_t real;
+        if (!TryReal(&real) || !block->virtualContains(vaddr + offset + sizeof(T) - 1))
+            return false;
+        *value = *reinterpret_cast<T *>(real + offset);
+        return true;
+    }
+
     uint64_t vaddr;
     LoadBlock* block;
 };
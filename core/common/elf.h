@@ -37,6 +37,9 @@
 #ifndef NT_ARM_PAC_ENABLED_KEYS
 #define NT_ARM_PAC_ENABLED_KEYS 0x40A
 #endif
+#ifndef NT_GNU_BUILD_ID
+#define NT_GNU_BUILD_ID 3
+#endif
 
 #define ELF_PAGE_SIZE 0x1000
 
@@ -23,6 +23,7 @@
 #include "common/exception.h"
 #include <linux/elf.h>
 #include <cxxabi.h>
+#include <algorithm>
 
 struct LinkMap_OffsetTable __LinkMap_offset__;
 struct LinkMap_SizeTable __LinkMap_size__;
@@ -103,50 +104,89 @@ void LinkMap::NiceMethod(uint64_t pc, NiceSymbol& symbol) {
 
     LoadBlock* load = block();
     if (load) {
-        bool vdso = !strcmp(name(), "[vdso]") || load->vaddr() == CoreApi::FindAuxv(AT_SYSINFO_EHDR);
+        CheckSymbolIndex();
+
         uint64_t cloc_offset = (pc & CoreApi::GetVabitsMask()) - l_addr();
-        uint64_t nice_offset = 0;
-        uint64_t nice_size = 0;
-
-        const auto& it = std::find_if(symbols.begin(), symbols.end(),
-                [&](const SymbolEntry& entry) {
-                    uint64_t offset = entry.offset;
-                    if (CoreApi::GetMachine() == EM_ARM)
-                        offset &= (CoreApi::GetPointMask() - 1);
-
-                    if (offset > cloc_offset)
-                        return false;
-
-                    if (ELF_ST_TYPE(entry.type) == STT_FUNC
-                            || (vdso && ELF_ST_TYPE(entry.type) == STT_NOTYPE)) {
-                        if (cloc_offset < offset + entry.size)
-                            return true;
-                    }
-                    return false;
+        const auto& upper = std::upper_bound(symbol_index.begin(), symbol_index.end(), cloc_offset,
+                [](uint64_t offset, const SymbolRange& range) {
+                    return offset < range.offset;
                 });
 
-        if (it != symbols.end()) {
-            nice_offset = it->offset + l_addr();
-            if (CoreApi::GetMachine() == EM_ARM)
-                nice_offset &= (CoreApi::GetPointMask() - 1);
-            nice_size = it->size;
-            symbol.SetNiceMethod(it->symbol.data(), nice_offset, nice_size);
+        auto it = upper;
+        while (it != symbol_index.begin()) {
+            --it;
+            if (it->end <= cloc_offset)
+                break;
+
+            if (cloc_offset < it->offset + it->size) {
+                uint64_t nice_offset = it->offset + l_addr();
+                if (CoreApi::GetMachine() == EM_ARM)
+                    nice_offset &= (CoreApi::GetPointMask() - 1);
+                symbol.SetNiceMethod(it->entry->symbol.data(), nice_offset, it->size);
+                break;
+            }
         }
     }
 }
 
-SymbolEntry LinkMap::DlSymEntry(const char* symbol) {
+void LinkMap::BuildSymbolIndex() {
     std::unordered_set<SymbolEntry, SymbolEntry::Hash>& symbols = GetCurrentSymbols();
-    const auto& it = std::find_if(symbols.begin(), symbols.end(),
-            [&](const SymbolEntry& entry) {
-                return entry.symbol == symbol;
+    symbol_index.clear();
+    symbol_names.clear();
+    symbol_index_source = &symbols;
+    symbol_index_count = symbols.size();
+    LoadBlock* load = block();
+    symbol_index_block = load;
+    symbol_index_generation = load ? load->Generation() : 0;
+
+    for (const auto& entry : symbols) {
+        if (entry.symbol.length())
+            symbol_names.insert(std::pair<std::string_view, const SymbolEntry*>(entry.symbol, &entry));
+    }
+
+    if (!load) return;
+
+    bool vdso = !strcmp(name(), "[vdso]") || load->vaddr() == CoreApi::FindAuxv(AT_SYSINFO_EHDR);
+    for (const auto& entry : symbols) {
+        if (ELF_ST_TYPE(entry.type) != STT_FUNC
+                && !(vdso && ELF_ST_TYPE(entry.type) == STT_NOTYPE))
+            continue;
+
+        SymbolRange range;
+        range.offset = entry.offset;
+        if (CoreApi::GetMachine() == EM_ARM)
+            range.offset &= (CoreApi::GetPointMask() - 1);
+        range.size = entry.size;
+        range.entry = &entry;
+        symbol_index.push_back(range);
+    }
+
+    std::sort(symbol_index.begin(), symbol_index.end(),
+            [](const SymbolRange& a, const SymbolRange& b) {
+                if (a.offset != b.offset)
+                    return a.offset < b.offset;
+                if (a.size != b.size)
+                    return a.size > b.size;
+                return a.entry->symbol < b.entry->symbol;
             });
-    if (it != symbols.end())
-        return *it;
+
+    uint64_t end = 0;
+    for (auto& range : symbol_index) {
+        end = std::max(end, range.offset + range.size);
+        range.end = end;
+    }
+}
+
+SymbolEntry LinkMap::DlSymEntry(const char* symbol) {
+    std::unordered_map<std::string_view, const SymbolEntry*>& names = GetSymbolNames();
+    const auto& it = names.find(symbol);
+    if (it != names.end())
+        return *it->second;
     return SymbolEntry::Invalid();
 }
 
 void LinkMap::ReadSymbols() {
+    CoreApi::CleanSymbolIndex();
     LoadBlock* load = block();
     if (load && load->isMmapBlock()) {
         std::unordered_set<SymbolEntry, SymbolEntry::Hash>& symbols = load->GetSymbols();
@@ -157,6 +197,7 @@ void LinkMap::ReadSymbols() {
             lp32::Core::readsym32(this);
         }
         if (symbols.size()) LOGI(ANSI_COLOR_GREEN "Read symbols[%ld] (%s)\n" ANSI_COLOR_RESET, symbols.size(), name());
+        BuildSymbolIndex();
     } else {
         dynsyms.clear();
         try {
@@ -164,6 +205,7 @@ void LinkMap::ReadSymbols() {
         } catch(InvalidAddressException e) {
         }
         if (dynsyms.size()) LOGD("Read dynsyms[%ld] (%s)\n", dynsyms.size(), name());
+        BuildSymbolIndex();
     }
 }
 
@@ -19,7 +19,10 @@
 
 #include "api/memory_ref.h"
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 struct LinkMap_OffsetTable {
     uint32_t l_addr;
@@ -41,7 +44,7 @@ public:
     LinkMap(uint64_t m) : api::MemoryRef(m) {
         ReadSymbols();
     }
-    ~LinkMap() { dynsyms.clear(); }
+    ~LinkMap() { symbol_index.clear(); symbol_names.clear(); dynsyms.clear(); }
     static void Init();
     inline uint64_t l_addr() { return VALUEOF(LinkMap, l_addr); }
     inline uint64_t l_name() { return VALUEOF(LinkMap, l_name); }
@@ -80,10 +83,42 @@ public:
     api::MemoryRef& GetNameCache();
     inline std::unordered_set<SymbolEntry, SymbolEntry::Hash>& GetDynsyms() { return dynsyms; }
     std::unordered_set<SymbolEntry, SymbolEntry::Hash>& GetCurrentSymbols();
+
+    /*
+     * NiceMethod candidates sorted by offset, end is the max end of
+     * [0, idx], so an interval containing pc is found by going back
+     * from the upper bound until end <= pc.
+     */
+    class SymbolRange {
+    public:
+        uint64_t offset;
+        uint64_t size;
+        uint64_t end;
+        const SymbolEntry* entry;
+    };
+    void BuildSymbolIndex();
+    inline void CheckSymbolIndex() {
+        std::unordered_set<SymbolEntry, SymbolEntry::Hash>& symbols = GetCurrentSymbols();
+        LoadBlock* load = block();
+        if (symbol_index_source != &symbols || symbol_index_count != symbols.size()
+                || symbol_index_block != load
+                || (load && symbol_index_generation != load->Generation()))
+            BuildSymbolIndex();
+    }
+    inline std::unordered_map<std::string_view, const SymbolEntry*>& GetSymbolNames() {
+        CheckSymbolIndex();
+        return symbol_names;
+    }
 private:
     api::MemoryRef addr_cache = 0x0;
     api::MemoryRef name_cache = 0x0;
     std::unordered_set<SymbolEntry, SymbolEntry::Hash> dynsyms;
+    std::vector<SymbolRange> symbol_index;
+    std::unordered_map<std::string_view, const SymbolEntry*> symbol_names;
+    std::unordered_set<SymbolEntry, SymbolEntry::Hash>* symbol_index_source = nullptr;
+    uint64_t symbol_index_count = 0;
+    LoadBlock* symbol_index_block = nullptr;
+    uint64_t symbol_index_generation = 0;
 };
 
 #endif  // CORE_COMMON_LINKMAP_H_
@@ -28,6 +28,8 @@ void LoadBlock::setMmapFile(const char* file, uint64_t offset) {
                    reinterpret_cast<uint64_t *>(map->data()),
                    map->realSize());
         mMmap = std::move(map);
+        mGeneration++;
+        CoreApi::CleanRealTable();
     }
 }
 
@@ -35,8 +37,11 @@ bool LoadBlock::newOverlay() {
     if (!mOverlay) {
         std::unique_ptr<MemoryMap> map;
         if (isValid()) {
-            std::unique_ptr<MemoryMap> tmp(MemoryMap::MmapMem(
-                begin(), size(), !isMmapBlock()? size() : mMmap->realSize()));
+            uint64_t real_size = !isMmapBlock()? size() : mMmap->realSize();
+            // share untouched pages with the backing file, copy only written ones.
+            MemoryMap* backing = isMmapBlock() ? mMmap.get() : CoreApi::GetCoreMap();
+            std::unique_ptr<MemoryMap> tmp(backing ? backing->CopyOnWrite(begin(), size(), real_size) : nullptr);
+            if (!tmp) tmp.reset(MemoryMap::MmapMem(begin(), size(), real_size));
             map = std::move(tmp);
         } else {
             std::unique_ptr<MemoryMap> tmp(MemoryMap::MmapZeroMem(size()));
@@ -44,6 +49,8 @@ bool LoadBlock::newOverlay() {
         }
         if (map) {
             mOverlay = std::move(map);
+            mGeneration++;
+            CoreApi::CleanRealTable();
             LOGI("New overlay [%lx, %lx)\n", vaddr(), vaddr() + size());
         }
     }
@@ -61,7 +68,10 @@ void LoadBlock::removeMmap() {
     if (mMmap) {
         LOGI("Remove mmap [%lx, %lx) %s\n", vaddr(), vaddr() + size(), name().c_str());
         mSymbols.clear();
+        CoreApi::CleanSymbolIndex();
         mMmap.reset();
+        mGeneration++;
+        CoreApi::CleanRealTable();
     }
 }
 
@@ -70,6 +80,8 @@ void LoadBlock::removeOverlay() {
         if (!isFake()) {
             LOGI("Remove overlay [%lx, %lx)\n", vaddr(), vaddr() + size());
             mOverlay.reset();
+            mGeneration++;
+            CoreApi::CleanRealTable();
         } else {
             LOGE("Can't remove fake load\n");
         }
@@ -112,7 +124,7 @@ uint32_t LoadBlock::GetCRC32(int opt) {
     }
     if (oraddr() && (opt & OPT_READ_OR)) {
         if (!mCRC32 && isValidBlock()) {
-            mCRC32 = Utils::CRC32(reinterpret_cast<uint8_t *>(begin(LoadBlock::OPT_READ_OR)), realSize());
+            mCRC32 = Utils::ParallelCRC32(reinterpret_cast<uint8_t *>(begin(LoadBlock::OPT_READ_OR)), realSize());
         }
         return mCRC32;
     }
@@ -93,6 +93,7 @@ public:
         mPointMask = 0x0;
         mCRC32 = 0x0;
         mLinkMap = nullptr;
+        mGeneration = 0;
     }
 
     void setMmapFile(const char* file, uint64_t offset);
@@ -107,8 +108,10 @@ public:
     inline uint64_t VabitsMask() { return mVabitsMask; }
     inline uint64_t PointMask() { return mPointMask; }
     inline uint64_t GetMmapOffset() { return mMmap->offset(); }
-    inline void setMmapMemoryMap(std::unique_ptr<MemoryMap>& map) { mMmap = std::move(map); }
+    inline void setMmapMemoryMap(std::unique_ptr<MemoryMap>& map) { mMmap = std::move(map); mGeneration++; }
     inline std::unordered_set<SymbolEntry, SymbolEntry::Hash>& GetSymbols() { return mSymbols; }
+    // bumped whenever the mmap file or overlay backing this block is replaced.
+    inline uint64_t Generation() { return mGeneration; }
     bool CheckCanMmap(uint64_t header);
     uint32_t GetCRC32(int opt);
     void bind(LinkMap* map) { mLinkMap = map; }
@@ -123,6 +126,7 @@ private:
     uint64_t mPointMask;
     uint32_t mCRC32;
     LinkMap* mLinkMap;
+    uint64_t mGeneration;
     std::unique_ptr<MemoryMap> mMmap;
     std::unordered_set<SymbolEntry, SymbolEntry::Hash> mSymbols;
 };
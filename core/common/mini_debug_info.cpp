@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logger/log.h"
+#include "common/elf.h"
+#include "common/mini_debug_info.h"
+#include "base/utils.h"
+#include "zip/xz.h"
+#include <stdio.h>
+#include <string.h>
+#include <linux/elf.h>
+
+std::mutex MiniDebugInfo::kLock;
+std::unordered_map<std::string, std::unique_ptr<std::vector<SymbolEntry>>> MiniDebugInfo::kCaches;
+
+std::string MiniDebugInfo::BuildId(const uint8_t* note, uint64_t size) {
+    std::string build_id;
+    uint64_t pos = 0;
+    // Elf32_Nhdr and Elf64_Nhdr are the same layout.
+    while (pos + sizeof(Elf64_Nhdr) <= size) {
+        const Elf64_Nhdr* nhdr = reinterpret_cast<const Elf64_Nhdr*>(note + pos);
+        uint64_t name_pos = pos + sizeof(Elf64_Nhdr);
+        uint64_t desc_pos = name_pos + ((nhdr->n_namesz + 3) & ~3);
+        uint64_t next = desc_pos + ((nhdr->n_descsz + 3) & ~3);
+        if (next > size)
+            break;
+
+        if (nhdr->n_type == NT_GNU_BUILD_ID
+                && nhdr->n_namesz == 4
+                && !memcmp(note + name_pos, "GNU", 4)) {
+            char hex[3];
+            for (uint32_t i = 0; i < nhdr->n_descsz; ++i) {
+                snprintf(hex, sizeof(hex), "%02x", note[desc_pos + i]);
+                build_id.append(hex);
+            }
+            break;
+        }
+        pos = next;
+    }
+    return build_id;
+}
+
+std::string MiniDebugInfo::GetKey(const char* file, std::string& build_id, uint64_t offset, uint64_t size) {
+    std::string key = file;
+    key.append("@");
+    if (build_id.length()) {
+        key.append(build_id);
+    } else {
+        // no build-id, at least distinguish different sections.
+        key.append(Utils::ToHex(offset));
+        key.append(":");
+        key.append(Utils::ToHex(size));
+    }
+    return key;
+}
+
+template<typename Ehdr, typename Shdr, typename Sym>
+const std::vector<SymbolEntry>& MiniDebugInfo::Load(std::string& key, const uint8_t* data, uint64_t size) {
+    std::lock_guard<std::mutex> guard(kLock);
+    std::unique_ptr<std::vector<SymbolEntry>>& cache = kCaches[key];
+    if (cache)
+        return *cache;
+
+    // cache failed result too, don't decompress again.
+    cache = std::make_unique<std::vector<SymbolEntry>>();
+    std::vector<uint8_t> debugdata;
+    if (Decompress(data, size, debugdata))
+        ReadSymbols<Ehdr, Shdr, Sym>(debugdata.data(), debugdata.size(), *cache);
+    return *cache;
+}
+
+template<typename Ehdr, typename Shdr, typename Sym>
+void MiniDebugInfo::ReadSymbols(const uint8_t* data, uint64_t size, std::vector<SymbolEntry>& entries) {
+    constexpr uint8_t elf_class = sizeof(Ehdr) == sizeof(Elf64_Ehdr) ? ELFCLASS64 : ELFCLASS32;
+    if (size < sizeof(Ehdr))
+        return;
+
+    const Ehdr* ehdr = reinterpret_cast<const Ehdr*>(data);
+    if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG)
+            || ehdr->e_ident[EI_CLASS] != elf_class
+            || ehdr->e_shentsize != sizeof(Shdr)
+            || ehdr->e_shoff > size
+            || ehdr->e_shnum > (size - ehdr->e_shoff) / sizeof(Shdr))
+        return;
+
+    const Shdr* shdr = reinterpret_cast<const Shdr*>(data + ehdr->e_shoff);
+    for (uint32_t i = 0; i < ehdr->e_shnum; ++i) {
+        if (shdr[i].sh_type != SHT_SYMTAB
+                || shdr[i].sh_entsize != sizeof(Sym)
+                || shdr[i].sh_link >= ehdr->e_shnum)
+            continue;
+
+        const Shdr& strshdr = shdr[shdr[i].sh_link];
+        if (shdr[i].sh_offset > size || shdr[i].sh_size > size - shdr[i].sh_offset
+                || strshdr.sh_offset > size || strshdr.sh_size > size - strshdr.sh_offset
+                || !strshdr.sh_size)
+            continue;
+
+        const char* strtab = reinterpret_cast<const char*>(data + strshdr.sh_offset);
+        // every name must end inside the table.
+        if (strtab[strshdr.sh_size - 1])
+            continue;
+
+        uint64_t count = shdr[i].sh_size / sizeof(Sym);
+        const Sym* symtab = reinterpret_cast<const Sym*>(data + shdr[i].sh_offset);
+        for (uint64_t k = 0; k < count; ++k) {
+            if (symtab[k].st_value && symtab[k].st_size && symtab[k].st_name < strshdr.sh_size) {
+                entries.push_back(SymbolEntry(symtab[k].st_value, symtab[k].st_info, symtab[k].st_size,
+                                              strtab + symtab[k].st_name));
+            }
+        }
+    }
+}
+
+template const std::vector<SymbolEntry>& MiniDebugInfo::Load<Elf32_Ehdr, Elf32_Shdr, Elf32_Sym>(
+        std::string& key, const uint8_t* data, uint64_t size);
+template const std::vector<SymbolEntry>& MiniDebugInfo::Load<Elf64_Ehdr, Elf64_Shdr, Elf64_Sym>(
+        std::string& key, const uint8_t* data, uint64_t size);
+
+bool MiniDebugInfo::Decompress(const uint8_t* data, uint64_t size, std::vector<uint8_t>& out) {
+    if (!Xz::IsSupported()) {
+        LOGD("Not support .gnu_debugdata, build without liblzma.\n");
+        return false;
+    }
+    return Xz::Decompress(data, size, out);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CORE_COMMON_MINI_DEBUG_INFO_H_
+#define CORE_COMMON_MINI_DEBUG_INFO_H_
+
+#include "common/syment.h"
+#include <stdint.h>
+#include <sys/types.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/*
+ * .gnu_debugdata is a xz compressed ELF which only keeps .symtab,
+ * decoded symbols are cached by file and build-id.
+ */
+class MiniDebugInfo {
+public:
+    static std::string BuildId(const uint8_t* note, uint64_t size);
+    static std::string GetKey(const char* file, std::string& build_id, uint64_t offset, uint64_t size);
+    /*
+     * Symbols of a compressed .gnu_debugdata, decoded on the first call of key,
+     * later calls and failed decodes return the cached result. Thread safe.
+     */
+    template<typename Ehdr, typename Shdr, typename Sym>
+    static const std::vector<SymbolEntry>& Load(std::string& key, const uint8_t* data, uint64_t size);
+private:
+    static bool Decompress(const uint8_t* data, uint64_t size, std::vector<uint8_t>& out);
+    template<typename Ehdr, typename Shdr, typename Sym>
+    static void ReadSymbols(const uint8_t* data, uint64_t size, std::vector<SymbolEntry>& entries);
+
+    static std::mutex kLock;
+    static std::unordered_map<std::string, std::unique_ptr<std::vector<SymbolEntry>>> kCaches;
+};
+
+#endif  // CORE_COMMON_MINI_DEBUG_INFO_H_
@@ -22,6 +22,7 @@
 #include "common/bit.h"
 #include "common/load_block.h"
 #include "common/exception.h"
+#include "common/mini_debug_info.h"
 #include <string.h>
 #include <linux/elf.h>
 
@@ -98,6 +99,7 @@ bool lp32::Core::load32(CoreApi* api, std::function<void* (uint64_t, uint64_t)>
             api->addNoteBlock(block);
         }
     }
+    api->buildFileTable();
     LOGI("Core load (%p) %s\n", this, api->getName().c_str());
     return true;
 }
@@ -271,6 +273,7 @@ void lp32::Core::readsym32(::LinkMap* handle) {
         int symtabndx = -1;
         int strtabndx = -1;
         int gnu_debugdatandx = -1;
+        int buildidndx = -1;
 
         int sh_num = ehdr->e_shnum;
         Elf32_Shdr* shdr = reinterpret_cast<Elf32_Shdr*>(map->data() + ehdr->e_shoff);
@@ -300,6 +303,11 @@ void lp32::Core::readsym32(::LinkMap* handle) {
                 gnu_debugdatandx = i;
                 continue;
             }
+
+            if (!strcmp(shstr + shdr[i].sh_name, ".note.gnu.build-id")) {
+                buildidndx = i;
+                continue;
+            }
         }
 
         // scan dynsym
@@ -332,5 +340,18 @@ void lp32::Core::readsym32(::LinkMap* handle) {
         }
 
         // scan gnu_debugdata
+        if (gnu_debugdatandx > 0) {
+            std::string build_id;
+            if (buildidndx > 0) {
+                build_id = MiniDebugInfo::BuildId(reinterpret_cast<uint8_t*>(map->data() + shdr[buildidndx].sh_offset),
+                                                  shdr[buildidndx].sh_size);
+            }
+            std::string key = MiniDebugInfo::GetKey(handle->block()->name().c_str(), build_id,
+                                                    shdr[gnu_debugdatandx].sh_offset, shdr[gnu_debugdatandx].sh_size);
+            const std::vector<SymbolEntry>& entries = MiniDebugInfo::Load<Elf32_Ehdr, Elf32_Shdr, Elf32_Sym>(key,
+                    reinterpret_cast<uint8_t*>(map->data() + shdr[gnu_debugdatandx].sh_offset),
+                    shdr[gnu_debugdatandx].sh_size);
+            symbols.insert(entries.begin(), entries.end());
+        }
     }
 }
@@ -19,7 +19,11 @@
 #include "command/cmd_print.h"
 #include "dex/modifiers.h"
 #include "android.h"
+#include "runtime/runtime.h"
 #include "runtime/mirror/iftable.h"
+#include "runtime/class_linker.h"
+#include "dex/descriptors_names.h"
+#include "common/exception.h"
 #include "api/core.h"
 #include <stdio.h>
 #include <unistd.h>
@@ -83,6 +87,17 @@ int ClassCommand::main(int argc, char* const argv[]) {
         }
     }
 
+    show_flag = !show_flag ? SHOW_ALL : show_flag;
+    total_classes = 0;
+    if (optind < argc) dump_all = false;
+
+    const char* classname = argv[optind];
+    class_info = &art::Runtime::Current().GetHeap().GetClassInfoCache();
+
+    // loaded classes are all in the class linker tables, no need to walk the heap.
+    if (!obj_each_flags && VisitClassTables(classname))
+        return 0;
+
     if (!obj_each_flags) {
         obj_each_flags |= Android::EACH_APP_OBJECTS;
         obj_each_flags |= Android::EACH_ZYGOTE_OBJECTS;
@@ -90,37 +105,94 @@ int ClassCommand::main(int argc, char* const argv[]) {
         obj_each_flags |= Android::EACH_FAKE_OBJECTS;
     }
 
-    show_flag = !show_flag ? SHOW_ALL : show_flag;
-    total_classes = 0;
-    if (optind < argc) dump_all = false;
-
-    const char* classname = argv[optind];
-    auto callback = [&](art::mirror::Object& object) -> bool {
-        return PrintClass(object, classname);
+    auto callback = [&](ClassCommand::Result& result, art::mirror::Object& object) -> bool {
+        if (MatchClass(object, classname))
+            result.classes.push_back(object);
+        return false;
+    };
+    auto merge = [&](ClassCommand::Result& result) {
+        for (auto& clazz : result.classes) {
+            PrintClass(clazz);
+        }
     };
 
     try {
-        Android::ForeachObjects(callback, obj_each_flags, false);
+        Android::ParallelForeachObjects<ClassCommand::Result>(callback, merge, obj_each_flags, false);
     } catch(InvalidAddressException e) {
         LOGW("The statistical process was interrupted!\n");
     }
     return 0;
 }
 
-bool ClassCommand::PrintClass(art::mirror::Object& object, const char* classname) {
-    if (!object.IsClass())
+/*
+ * java.lang.String[] -> [Ljava/lang/String;
+ */
+static std::string PrettyToDescriptor(const char* classname) {
+    std::string name = classname;
+    std::string dims;
+    while (name.size() > 2 && !name.compare(name.size() - 2, 2, "[]")) {
+        name.resize(name.size() - 2);
+        dims.push_back('[');
+    }
+
+    static const char* primitives[][2] = {
+        {"boolean", "Z"}, {"byte", "B"}, {"char", "C"}, {"short", "S"},
+        {"int", "I"}, {"long", "J"}, {"float", "F"}, {"double", "D"}, {"void", "V"},
+    };
+    for (const auto& primitive : primitives) {
+        if (name == primitive[0])
+            return dims + primitive[1];
+    }
+    return dims + art::DotToDescriptor(name.c_str());
+}
+
+bool ClassCommand::VisitClassTables(const char* classname) {
+    std::vector<uint32_t> classes;
+    try {
+        art::ClassLinker& linker = art::Runtime::Current().GetClassLinker();
+        if (dump_all) {
+            classes = linker.GetClasses();
+        } else {
+            linker.LookupClasses(PrettyToDescriptor(classname).c_str(), classes);
+        }
+    } catch(InvalidAddressException e) {
+        return false;
+    }
+
+    // class tables not decoded, or the class is gone from them.
+    if (!classes.size())
+        return false;
+
+    for (const auto& klass : classes) {
+        art::mirror::Class clazz = klass;
+        try {
+            PrintClass(clazz);
+        } catch(InvalidAddressException e) {
+            LOGW("Class(0x%x) print fail.\n", klass);
+        }
+    }
+    return true;
+}
+
+bool ClassCommand::MatchClass(art::mirror::Object& object, const char* classname) {
+    if (!class_info->GetClassInfoOf(object).IsClass())
         return false;
 
+    if (dump_all)
+        return true;
+
     art::mirror::Class thiz = object;
+    return class_info->GetDescriptor(thiz) == classname;
+}
+
+void ClassCommand::PrintClass(art::mirror::Class& clazz) {
     if (dump_all) {
         total_classes++;
         LOGI("[%ld] " ANSI_COLOR_LIGHTYELLOW "0x%lx" ANSI_COLOR_LIGHTCYAN " %s\n" ANSI_COLOR_RESET,
-                total_classes, thiz.Ptr(), thiz.PrettyDescriptor().c_str());
-    } else if (thiz.PrettyDescriptor() == classname) {
-        PrintPrettyClassContent(thiz);
+                total_classes, clazz.Ptr(), class_info->GetDescriptor(clazz).c_str());
+    } else {
+        PrintPrettyClassContent(clazz);
     }
-
-    return false;
 }
 
 void ClassCommand::PrintPrettyClassContent(art::mirror::Class& clazz) {
@@ -224,7 +296,7 @@ void ClassCommand::usage() {
     LOGI("    -s, --static       show static field\n");
     LOGI("    -f, --field        show instance field\n");
     LOGI("    -x, --hex          basic type hex print\n");
-    LOGI("Type: {--app, --zygote, --image, --fake}\n");
+    LOGI("Type: {--app, --zygote, --image, --fake}, default lookup class linker tables.\n");
     ENTER();
     LOGI("core-parser> class android.net.wifi.WifiNetworkSpecifier\n");
     LOGI("[0x71c530a0]\n");
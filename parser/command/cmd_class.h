@@ -20,8 +20,10 @@
 #include "command/command.h"
 #include "runtime/mirror/object.h"
 #include "runtime/mirror/class.h"
+#include "runtime/mirror/class_info.h"
 #include "android.h"
 #include <string>
+#include <vector>
 
 class ClassCommand : public Command {
 public:
@@ -40,15 +42,23 @@ public:
         return true;
     }
     void usage();
-    bool PrintClass(art::mirror::Object& object, const char* classname);
+    bool MatchClass(art::mirror::Object& object, const char* classname);
+    bool VisitClassTables(const char* classname);
+    void PrintClass(art::mirror::Class& clazz);
     void PrintPrettyClassContent(art::mirror::Class& clazz);
     void PrintField(const char* format, art::mirror::Class& clazz, art::ArtField& field);
+
+    class Result {
+    public:
+        std::vector<art::mirror::Class> classes;
+    };
 private:
     uint64_t total_classes;
     bool dump_all;
     bool format_hex;
     int show_flag;
     int obj_each_flags;
+    art::mirror::ClassInfoCache* class_info;
 };
 
 #endif // PARSER_COMMAND_CMD_CLASS_H_
@@ -25,6 +25,7 @@
 #include "common/disassemble/capstone.h"
 #include "base/utils.h"
 #include "base/macros.h"
+#include "base/thread_pool.h"
 #include <linux/elf.h>
 #include <unistd.h>
 #include <getopt.h>
@@ -73,10 +74,11 @@ int EnvCommand::onConfigChanged(int argc, char* const argv[]) {
         {"pid",     required_argument, 0, 'p'},
         {"sdk",     required_argument, 0,  0 },
         {"oat",     required_argument, 0,  1 },
+        {"jobs",    required_argument, 0, 'j'},
         {0,         0,                 0,  0 }
     };
 
-    while ((opt = getopt_long(argc, argv, "p:0:1:",
+    while ((opt = getopt_long(argc, argv, "p:0:1:j:",
                 long_options, &option_index)) != -1) {
         switch (opt) {
             case 'p':
@@ -96,6 +98,10 @@ int EnvCommand::onConfigChanged(int argc, char* const argv[]) {
                     Android::OnOatChanged(current_oat);
                 }
                 break;
+            case 'j':
+                ThreadPool::SetWorkers(atoi(optarg));
+                LOGI("Switch workers(%d) env.\n", ThreadPool::GetWorkers());
+                break;
         }
     }
 
@@ -253,6 +259,7 @@ int EnvCommand::showCoreEnv(int argc, char* const argv[]) {
         LOGI("  * mLoad: " ANSI_COLOR_LIGHTMAGENTA "%ld\n" ANSI_COLOR_RESET, CoreApi::GetLoads(false).size());
         LOGI("  * mQuickLoad: " ANSI_COLOR_LIGHTMAGENTA "%ld\n" ANSI_COLOR_RESET, CoreApi::GetLoads(true).size());
         LOGI("  * mLinkMap: " ANSI_COLOR_LIGHTMAGENTA "%ld\n" ANSI_COLOR_RESET, CoreApi::GetLinkMaps().size());
+        LOGI("  * workers: " ANSI_COLOR_LIGHTMAGENTA "%d\n" ANSI_COLOR_RESET, ThreadPool::GetWorkers());
     }
     return 0;
 }
@@ -322,9 +329,9 @@ int EnvCommand::clocLoadCRC32(int num) {
             ElfHeader* header = reinterpret_cast<ElfHeader*>(block->begin(LoadBlock::OPT_READ_MMAP));
             if (!memcmp(header->ident, ELFMAG, 4)) {
                 // skip elf header
-                or_crc = Utils::CRC32(reinterpret_cast<uint8_t*>(block->begin(LoadBlock::OPT_READ_OR)) + SIZEOF(Elfx_Ehdr),
+                or_crc = Utils::ParallelCRC32(reinterpret_cast<uint8_t*>(block->begin(LoadBlock::OPT_READ_OR)) + SIZEOF(Elfx_Ehdr),
                         block->size() - SIZEOF(Elfx_Ehdr));
-                mmap_crc = Utils::CRC32(reinterpret_cast<uint8_t*>(block->begin(LoadBlock::OPT_READ_MMAP)) + SIZEOF(Elfx_Ehdr),
+                mmap_crc = Utils::ParallelCRC32(reinterpret_cast<uint8_t*>(block->begin(LoadBlock::OPT_READ_MMAP)) + SIZEOF(Elfx_Ehdr),
                         block->size() - SIZEOF(Elfx_Ehdr));
             } else {
                 or_crc = block->GetCRC32(LoadBlock::OPT_READ_OR);
@@ -410,6 +417,7 @@ void EnvCommand::usage() {
     LOGI("        --sdk <VERSION>   set current sdk version\n");
     LOGI("        --oat <VERSION>   set current oat version\n");
     LOGI("    -p, --pid <PID>       set current thread\n");
+    LOGI("    -j, --jobs <NUM>      set heap walk workers, 0 is default\n");
     ENTER();
     LOGI("core-parser> env config --sdk 30\n");
     LOGI("Switch android(30) env.\n");
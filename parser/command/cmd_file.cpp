@@ -24,32 +24,35 @@ int FileCommand::main(int argc, char* const argv[]) {
     if (!CoreApi::IsReady())
         return 0;
 
-    uint64_t address = 0x0;
-    if (argc > 1) address = Utils::atol(argv[1]) & CoreApi::GetVabitsMask();
-    auto callback = [argc, address](File* file) -> bool {
-        if (!(argc > 1)) {
-            LOGI(ANSI_COLOR_CYAN "[%lx, %lx)" ANSI_COLOR_RESET "  %016lx  " ANSI_COLOR_GREEN "%s\n" ANSI_COLOR_RESET,
-                    file->begin(), file->end(),
-                    file->offset(), file->name().c_str());
-        } else {
-            if (address >= file->begin() && address < file->end()) {
-                LOGI(ANSI_COLOR_CYAN "[%lx, %lx)" ANSI_COLOR_RESET "  %016lx  " ANSI_COLOR_GREEN "%s\n" ANSI_COLOR_RESET,
-                        file->begin(), file->end(),
-                        file->offset(), file->name().c_str());
-                return true;
-            }
-        }
-        return false;
+    auto print = [](File* file) {
+        LOGI(ANSI_COLOR_CYAN "[%lx, %lx)" ANSI_COLOR_RESET "  %016lx  " ANSI_COLOR_GREEN "%s\n" ANSI_COLOR_RESET,
+                file->begin(), file->end(),
+                file->offset(), file->name().c_str());
     };
 
-    CoreApi::ForeachFile(callback);
+    if (!(argc > 1)) {
+        auto callback = [&](File* file) -> bool {
+            print(file);
+            return false;
+        };
+        CoreApi::ForeachFile(callback);
+    } else if (argv[1][0] == '/') {
+        std::vector<File*>* files = CoreApi::FindFiles(argv[1]);
+        if (files) {
+            for (const auto& file : *files)
+                print(file);
+        }
+    } else {
+        File* file = CoreApi::FindFile(Utils::atol(argv[1]));
+        if (file) print(file);
+    }
     return 0;
 }
 
 void FileCommand::usage() {
-    LOGI("Usage: file [ADDRESS]\n");
+    LOGI("Usage: file [ADDRESS|PATH]\n");
     ENTER();
-    LOGI("core-parser> file | grep app_process\n");
+    LOGI("core-parser> file /system/bin/app_process64\n");
     LOGI("[5a224127f000, 5a2241282000)  0000000000000000  /system/bin/app_process64\n");
     LOGI("[5a2241282000, 5a2241286000)  0000000000002000  /system/bin/app_process64\n");
     LOGI("[5a2241286000, 5a2241288000)  0000000000005000  /system/bin/app_process64\n");
@@ -19,6 +19,7 @@
 #include "android.h"
 #include "command/cmd_hprof.h"
 #include "runtime/hprof/hprof.h"
+#include "zip/compressor.h"
 #include <unistd.h>
 #include <getopt.h>
 
@@ -27,7 +28,7 @@ int HprofCommand::main(int argc, char* const argv[]) {
         return 0;
 
     bool visible = false;
-    bool quick = false;
+    int compress = Compressor::TYPE_NONE;
 
     int opt;
     int option_index = 0;
@@ -35,17 +36,25 @@ int HprofCommand::main(int argc, char* const argv[]) {
     static struct option long_options[] = {
         {"visible",  no_argument,      0, 'v'},
         {"quick",    no_argument,      0, 'q'},
+        {"compress", required_argument, 0, 'z'},
         {0,          0,                0,  0 },
     };
 
-    while ((opt = getopt_long(argc, argv, "vq",
+    while ((opt = getopt_long(argc, argv, "vqz:",
                 long_options, &option_index)) != -1) {
         switch (opt) {
             case 'v':
                 visible = true;
                 break;
             case 'q':
-                quick = true;
+                // compatible, hprof is always single pass.
+                break;
+            case 'z':
+                compress = Compressor::TypeOf(optarg);
+                if (!Compressor::IsSupported(compress)) {
+                    LOGE("Not support compress \"%s\".\n", optarg);
+                    return 0;
+                }
                 break;
         }
     }
@@ -54,11 +63,12 @@ int HprofCommand::main(int argc, char* const argv[]) {
     if (!(optind < argc)) {
         filename = CoreApi::GetName();
         filename.append(".hprof");
+        filename.append(Compressor::Extension(compress));
     } else {
         filename = argv[optind];
     }
 
-    art::hprof::DumpHeap(filename.c_str(), visible, quick);
+    art::hprof::DumpHeap(filename.c_str(), visible, compress);
     return 0;
 }
 
@@ -66,10 +76,15 @@ void HprofCommand::usage() {
     LOGI("Usage: hprof [<FILE>] [OPTION]\n");
     LOGI("Option:\n");
     LOGI("    -v, --visible     show hprof detail\n");
-    LOGI("    -q, --quick       fast dump hprof\n");
+    LOGI("    -z, --compress    stream compressed output {gzip, zstd}\n");
     ENTER();
     LOGI("core-parser> hprof /tmp/1.hprof\n");
     LOGI("hprof: heap dump /tmp/1.hprof starting...\n");
     LOGI("hprof: heap dump completed, scan objects (306330).\n");
     LOGI("hprof: saved [/tmp/1.hprof].\n");
+    ENTER();
+    LOGI("core-parser> hprof /tmp/1.hprof.zst -z zstd\n");
+    LOGI("hprof: heap dump /tmp/1.hprof.zst starting...\n");
+    LOGI("hprof: heap dump completed, scan objects (306330).\n");
+    LOGI("hprof: saved [/tmp/1.hprof.zst].\n");
 }
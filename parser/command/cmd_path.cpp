@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logger/log.h"
+#include "command/cmd_path.h"
+#include "common/exception.h"
+#include "runtime/runtime.h"
+#include "runtime/gc/heap.h"
+#include "runtime/gc/heap_graph.h"
+#include "runtime/gc/heap_roots.h"
+#include "runtime/mirror/class.h"
+#include "runtime/mirror/array.h"
+#include "runtime/art_field.h"
+#include "api/core.h"
+#include "base/utils.h"
+#include "android.h"
+#include <unistd.h>
+#include <getopt.h>
+#include <vector>
+
+int PathCommand::main(int argc, char* const argv[]) {
+    if (!CoreApi::IsReady()
+            || !Android::IsSdkReady()
+            || !(argc > 1))
+        return 0;
+
+    art::gc::Heap& heap = art::Runtime::Current().GetHeap();
+    art::gc::HeapGraph& graph = heap.GetHeapGraph();
+    art::gc::HeapRoots& roots = heap.GetHeapRoots();
+
+    art::mirror::Object object = Utils::atol(argv[1]);
+    uint32_t idx = graph.IndexOf(object.Ptr());
+    if (idx == art::gc::HeapGraph::kInvalidIndex) {
+        LOGE("0x%lx is not an object of heap.\n", object.Ptr());
+        return 0;
+    }
+
+    std::vector<uint32_t> path;
+    if (!graph.ShortestPathToRoot(roots, idx, path)) {
+        LOGI(ANSI_COLOR_LIGHTRED "0x%lx is unreachable from gc roots.\n" ANSI_COLOR_RESET, object.Ptr());
+        return 0;
+    }
+
+    art::mirror::Object root = graph.AddressOf(path[0]);
+    std::string root_desc;
+    auto callback = [&](art::gc::HeapRoots::Root& value) -> bool {
+        if (!art::gc::HeapRoots::IsStrong(value.type))
+            return false;
+        if (root_desc.length()) root_desc.append(", ");
+        root_desc.append(art::gc::HeapRoots::RootTypeName(value.type));
+        if (value.thread_id) root_desc.append(" thread ").append(std::to_string(value.thread_id));
+        if (value.type == art::gc::kRootJavaFrame) root_desc.append(" frame #").append(std::to_string(value.index));
+        return false;
+    };
+    roots.ForeachRoot(root, callback);
+
+    LOGI(ANSI_COLOR_LIGHTRED "GC ROOT: %s\n" ANSI_COLOR_RESET, root_desc.c_str());
+    LOGI(ANSI_COLOR_LIGHTYELLOW "0x%lx" ANSI_COLOR_LIGHTCYAN " %s\n" ANSI_COLOR_RESET,
+            root.Ptr(), DescriptorOf(root).c_str());
+    std::string prefix = "  ";
+    for (size_t i = 1; i < path.size(); ++i) {
+        art::mirror::Object from = graph.AddressOf(path[i - 1]);
+        art::mirror::Object to = graph.AddressOf(path[i]);
+        LOGI("%s--> %s " ANSI_COLOR_LIGHTYELLOW "0x%lx" ANSI_COLOR_LIGHTCYAN " %s\n" ANSI_COLOR_RESET,
+                prefix.c_str(), FieldNameOf(from, to).c_str(), to.Ptr(), DescriptorOf(to).c_str());
+        prefix.append("  ");
+    }
+    return 0;
+}
+
+std::string PathCommand::FieldNameOf(art::mirror::Object& from, art::mirror::Object& to) {
+    std::string name;
+    try {
+        art::mirror::Class clazz = from.GetClass();
+        if (clazz.Ptr() == to.Ptr())
+            return "shadow$_klass_";
+
+        if (clazz.IsArrayClass()) {
+            art::mirror::Array array = from;
+            int32_t length = array.GetLength();
+            for (int32_t i = 0; i < length; ++i) {
+                api::MemoryRef ref(array.GetRawData(sizeof(uint32_t), i), array);
+                if (ref.value32Of() == to.Ptr())
+                    return "[" + std::to_string(i) + "]";
+            }
+            return "[?]";
+        }
+
+        auto callback = [&](art::ArtField& field) -> bool {
+            const char* type = field.GetTypeDescriptor();
+            if ((type[0] == 'L' || type[0] == '[') && field.GetObj(from) == to.Ptr()) {
+                name = field.GetName();
+                return true;
+            }
+            return false;
+        };
+        if (from.IsClass()) {
+            art::mirror::Class thiz = from;
+            Android::ForeachStaticField(thiz, callback);
+        }
+        art::mirror::Class super = clazz;
+        while (!name.length() && super.Ptr()) {
+            Android::ForeachInstanceField(super, callback);
+            super = super.GetSuperClass();
+        }
+    } catch(InvalidAddressException e) {}
+    return name.length() ? "." + name : "?";
+}
+
+std::string PathCommand::DescriptorOf(art::mirror::Object& object) {
+    try {
+        art::mirror::ClassInfoCache& cache = art::Runtime::Current().GetHeap().GetClassInfoCache();
+        const art::mirror::ClassInfo& info = cache.GetClassInfoOf(object);
+        if (info.IsClass()) {
+            art::mirror::Class thiz = object;
+            return info.descriptor + "<" + cache.GetDescriptor(thiz) + ">";
+        }
+        return info.descriptor;
+    } catch(InvalidAddressException e) {
+        return "<invalid>";
+    }
+}
+
+void PathCommand::usage() {
+    LOGI("Usage: path <OBJECT>\n");
+    LOGI("Shortest strong reference chain from gc roots, weak/soft/phantom referents are not followed.\n");
+    ENTER();
+    LOGI("core-parser> path 0x12c803d0\n");
+    LOGI("GC ROOT: STICKY_CLASS\n");
+    LOGI("0x6f9d1a80 java.lang.Class<android.app.ActivityThread>\n");
+    LOGI("  --> .sCurrentActivityThread 0x12c40020 android.app.ActivityThread\n");
+    LOGI("    --> .mActivities 0x12c803a0 android.util.ArrayMap\n");
+    LOGI("      --> .mArray 0x12c803d0 java.lang.Object[]\n");
+}
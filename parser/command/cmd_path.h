@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARSER_COMMAND_CMD_PATH_H_
+#define PARSER_COMMAND_CMD_PATH_H_
+
+#include "command/command.h"
+#include "runtime/mirror/object.h"
+#include "android.h"
+#include <string>
+
+class PathCommand : public Command {
+public:
+    PathCommand() : Command("path") {}
+    ~PathCommand() {}
+    int main(int argc, char* const argv[]);
+    bool prepare(int argc, char* const argv[]) {
+        Android::Prepare();
+        return true;
+    }
+    void usage();
+private:
+    static std::string FieldNameOf(art::mirror::Object& from, art::mirror::Object& to);
+    static std::string DescriptorOf(art::mirror::Object& object);
+};
+
+#endif // PARSER_COMMAND_CMD_PATH_H_
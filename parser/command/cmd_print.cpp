@@ -24,6 +24,7 @@
 #include "base/utils.h"
 #include "api/core.h"
 #include "runtime/runtime_globals.h"
+#include "runtime/runtime.h"
 #include "dex/modifiers.h"
 #include "dex/primitive.h"
 #include <stdlib.h>
@@ -156,46 +157,34 @@ void PrintCommand::DumpObject(art::mirror::Object& object) {
 
         if (reference) {
             LOGI(ANSI_COLOR_LIGHTRED "Reference:\n" ANSI_COLOR_RESET);
-            int cur_deep = 0;
-            auto callback = [&](art::mirror::Object& reference) -> bool {
-                return PrintReference(object, reference, cur_deep);
-            };
-            Android::ForeachObjects(callback);
+            art::gc::HeapGraph& graph = art::Runtime::Current().GetHeap().GetHeapGraph();
+            PrintReference(graph, object, 0);
         }
     }
 }
 
-bool PrintCommand::PrintReference(art::mirror::Object& object, art::mirror::Object& reference, int cur_deep) {
+void PrintCommand::PrintReference(art::gc::HeapGraph& graph, art::mirror::Object& object, int cur_deep) {
     if (cur_deep >= deep)
-        return true;
+        return;
 
-    uint64_t real_size = RoundUp(reference.SizeOf(), art::kObjectAlignment);
-    uint64_t count = real_size / sizeof(uint32_t);
     std::string prefix;
     for (int cur = -1; cur < cur_deep; ++cur) {
         prefix.append("  ");
     }
 
-    for (int pos = 0; pos < count; ++pos) {
-        if (object.Ptr() == reference.value32Of(pos * sizeof(uint32_t))) {
-            art::mirror::Class ref_thiz = 0x0;
-            if (reference.IsClass()) {
-                ref_thiz = reference;
-            } else {
-                ref_thiz = reference.GetClass();
-            }
-            LOGI("%s--> " ANSI_COLOR_LIGHTYELLOW "0x%lx " ANSI_COLOR_LIGHTCYAN "%s\n" ANSI_COLOR_RESET,
-                    prefix.c_str(), reference.Ptr(), ref_thiz.PrettyDescriptor().c_str());
-            if (cur_deep + 1 < deep) {
-                auto callback = [&](art::mirror::Object& second) -> bool {
-                    return PrintReference(reference, second, cur_deep + 1);
-                };
-                Android::ForeachObjects(callback);
-            }
-            break;
+    auto callback = [&](art::mirror::Object& reference) -> bool {
+        art::mirror::Class ref_thiz = 0x0;
+        if (reference.IsClass()) {
+            ref_thiz = reference;
+        } else {
+            ref_thiz = reference.GetClass();
         }
-    }
-    return false;;
+        LOGI("%s--> " ANSI_COLOR_LIGHTYELLOW "0x%lx " ANSI_COLOR_LIGHTCYAN "%s\n" ANSI_COLOR_RESET,
+                prefix.c_str(), reference.Ptr(), ref_thiz.PrettyDescriptor().c_str());
+        PrintReference(graph, reference, cur_deep + 1);
+        return false;
+    };
+    graph.ForeachReferrer(object, callback);
 }
 
 void PrintCommand::DumpClass(art::mirror::Class& clazz) {
@@ -22,6 +22,7 @@
 #include "runtime/mirror/class.h"
 #include "runtime/mirror/array.h"
 #include "runtime/art_field.h"
+#include "runtime/gc/heap_graph.h"
 #include "android.h"
 #include <string>
 
@@ -36,7 +37,7 @@ public:
     void DumpClass(art::mirror::Class& clazz);
     void DumpArray(art::mirror::Array& array);
     void DumpInstance(art::mirror::Object& object);
-    bool PrintReference(art::mirror::Object& object, art::mirror::Object& reference, int cur_deep);
+    void PrintReference(art::gc::HeapGraph& graph, art::mirror::Object& object, int cur_deep);
     static void PrintField(const char* format, art::mirror::Class& clazz,
                     art::mirror::Object& object, art::ArtField& field, bool format_hex);
     static std::string FormatSize(uint64_t size);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logger/log.h"
+#include "command/cmd_retained.h"
+#include "common/exception.h"
+#include "runtime/runtime.h"
+#include "runtime/gc/heap.h"
+#include "runtime/gc/heap_graph.h"
+#include "runtime/gc/heap_dominator.h"
+#include "api/core.h"
+#include "base/utils.h"
+#include "android.h"
+#include <stdlib.h>
+#include <unistd.h>
+#include <getopt.h>
+
+int RetainedCommand::main(int argc, char* const argv[]) {
+    if (!CoreApi::IsReady()
+            || !Android::IsSdkReady()
+            || !(argc > 1))
+        return 0;
+
+    uint32_t num = 10;
+
+    int opt;
+    int option_index = 0;
+    optind = 0; // reset
+    static struct option long_options[] = {
+        {"num",     required_argument, 0,  'n'},
+        {0,         0,                 0,   0 }
+    };
+
+    while ((opt = getopt_long(argc, argv, "n:",
+                long_options, &option_index)) != -1) {
+        switch (opt) {
+            case 'n': {
+                int value = atoi(optarg);
+                if (value < 0) {
+                    LOGE("Invalid num %s\n", optarg);
+                    return 0;
+                }
+                num = value;
+            } break;
+        }
+    }
+
+    if (optind >= argc) {
+        usage();
+        return 0;
+    }
+
+    art::gc::Heap& heap = art::Runtime::Current().GetHeap();
+    art::gc::HeapGraph& graph = heap.GetHeapGraph();
+    art::gc::HeapDominator& dominator = heap.GetHeapDominator();
+
+    art::mirror::Object object = Utils::atol(argv[optind]);
+    uint32_t idx = graph.IndexOf(object.Ptr());
+    if (idx == art::gc::HeapGraph::kInvalidIndex) {
+        LOGE("0x%lx is not an object of heap.\n", object.Ptr());
+        return 0;
+    }
+
+    LOGI("Object: " ANSI_COLOR_LIGHTYELLOW "0x%lx" ANSI_COLOR_LIGHTCYAN " %s\n" ANSI_COLOR_RESET,
+            object.Ptr(), DescriptorOf(object));
+    LOGI("Shallow: %ld\n", graph.SizeOf(idx));
+    if (!dominator.IsReachable(idx)) {
+        LOGI("Retained: 0 " ANSI_COLOR_LIGHTRED "(unreachable from gc roots)\n" ANSI_COLOR_RESET);
+        return 0;
+    }
+    LOGI("Retained: %ld\n", dominator.RetainedSize(idx));
+
+    uint32_t idom = dominator.ImmediateDominator(idx);
+    if (idom == dominator.Root()) {
+        LOGI("Dominator: " ANSI_COLOR_LIGHTRED "<GC ROOT>\n" ANSI_COLOR_RESET);
+    } else {
+        art::mirror::Object owner = graph.AddressOf(idom);
+        LOGI("Dominator: " ANSI_COLOR_LIGHTYELLOW "0x%lx" ANSI_COLOR_LIGHTCYAN " %s\n" ANSI_COLOR_RESET,
+                owner.Ptr(), DescriptorOf(owner));
+    }
+
+    uint32_t count = dominator.NumberOfDominated(idx);
+    if (!count || !num)
+        return 0;
+
+    // dominated objects are kept sorted by retained size.
+    uint32_t* dominated = dominator.Dominated(idx);
+    LOGI(ANSI_COLOR_LIGHTRED "Dominated: %d\n" ANSI_COLOR_RESET, count);
+    LOGI(ANSI_COLOR_LIGHTRED "Address         ShallowSize     RetainedSize     ClassName\n" ANSI_COLOR_RESET);
+    for (uint32_t i = 0; i < count && i < num; ++i) {
+        art::mirror::Object child = graph.AddressOf(dominated[i]);
+        LOGI(ANSI_COLOR_LIGHTYELLOW "0x%08lx" ANSI_COLOR_RESET "     %11ld      %11ld     " ANSI_COLOR_LIGHTCYAN "%s\n" ANSI_COLOR_RESET,
+                child.Ptr(), graph.SizeOf(dominated[i]), dominator.RetainedSize(dominated[i]), DescriptorOf(child));
+    }
+    return 0;
+}
+
+const char* RetainedCommand::DescriptorOf(art::mirror::Object& object) {
+    try {
+        art::mirror::ClassInfoCache& cache = art::Runtime::Current().GetHeap().GetClassInfoCache();
+        return cache.GetClassInfoOf(object).descriptor.c_str();
+    } catch(InvalidAddressException e) {
+        return "<invalid>";
+    }
+}
+
+void RetainedCommand::usage() {
+    LOGI("Usage: retained <OBJECT> [OPTION]\n");
+    LOGI("Option:\n");
+    LOGI("    -n, --num <NUM>   show top dominated objects (default 10)\n");
+    ENTER();
+    LOGI("core-parser> retained 0x12c803a0 -n 3\n");
+    LOGI("Object: 0x12c803a0 java.util.HashMap\n");
+    LOGI("Shallow: 48\n");
+    LOGI("Retained: 52384\n");
+    LOGI("Dominator: 0x6f9d1a80 android.app.ActivityThread\n");
+    LOGI("Dominated: 1\n");
+    LOGI("Address         ShallowSize     RetainedSize     ClassName\n");
+    LOGI("0x12c803d0             2064            52336     java.util.HashMap$Node[]\n");
+}
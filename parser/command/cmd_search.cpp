@@ -17,15 +17,17 @@
 #include "logger/log.h"
 #include "command/command_manager.h"
 #include "command/cmd_search.h"
-#include "java/lang/Object.h"
+#include "runtime/mirror/iftable.h"
 #include "base/utils.h"
 #include "api/core.h"
 #include "android.h"
+#include "runtime/runtime.h"
 #include <string.h>
 #include <unistd.h>
 #include <getopt.h>
 #include <sstream>
 #include <regex>
+#include <mutex>
 
 int SearchCommand::main(int argc, char* const argv[]) {
     if (!CoreApi::IsReady()
@@ -53,6 +55,7 @@ int SearchCommand::main(int argc, char* const argv[]) {
     type_flag = 0;
     each_flag = 0;
     regex = false;
+    instof = false;
     show = false;
     format_hex = false;
     while ((opt = getopt_long(argc, argv, "ocrpixs",
@@ -106,56 +109,171 @@ int SearchCommand::main(int argc, char* const argv[]) {
         each_flag |= Android::EACH_IMAGE_OBJECTS;
         each_flag |= Android::EACH_FAKE_OBJECTS;
     }
-    auto callback = [&](art::mirror::Object& object) -> bool {
-        return SearchObjects(classname, object);
+    int mode = Matcher::MATCH_LITERAL;
+    int length = strlen(classname);
+    if (regex) {
+        mode = Matcher::MATCH_REGEX;
+    } else if (instof) {
+        mode = Matcher::MATCH_INSTANCEOF;
+    } else if (length > 1 && classname[length - 1] == '*') {
+        mode = Matcher::MATCH_PREFIX;
+    }
+
+    class_info = &art::Runtime::Current().GetHeap().GetClassInfoCache();
+    try {
+        matcher.Compile(classname, mode, class_info);
+    } catch (std::regex_error& e) {
+        LOGE("Bad regular expression \"%s\": %s\n", classname, e.what());
+        return 0;
+    }
+
+    auto callback = [&](SearchCommand::Result& result, art::mirror::Object& object) -> bool {
+        SearchObjects(result, object);
+        return false;
+    };
+    auto merge = [&](SearchCommand::Result& result) {
+        for (auto& value : result.objects) {
+            ShowObject(value.first, *value.second);
+        }
     };
-    Android::ForeachObjects(callback, each_flag, false);
+    Android::ParallelForeachObjects<SearchCommand::Result>(callback, merge, each_flag, false);
     return 0;
 }
 
-bool SearchCommand::SearchObjects(const char* classsname, art::mirror::Object& object) {
-    int mask = object.IsClass() ? SEARCH_CLASS : SEARCH_OBJECT;
+void SearchCommand::Matcher::Compile(const char* pattern, int mode, art::mirror::ClassInfoCache* cache) {
+    mode_ = mode;
+    pattern_ = pattern;
+    cache_ = cache;
+    verdicts_.clear();
+    class_verdict_ = -1;
+    if (mode_ == MATCH_PREFIX) {
+        pattern_.pop_back();
+    } else if (mode_ == MATCH_REGEX) {
+        regex_ = std::regex(pattern_, std::regex::optimize);
+    }
+}
+
+bool SearchCommand::Matcher::Evaluate(art::mirror::Class& clazz) {
+    const std::string& descriptor = cache_->GetDescriptor(clazz);
+    if (descriptor == pattern_)
+        return true;
+
+    switch (mode_) {
+        case MATCH_PREFIX:
+            return descriptor.compare(0, pattern_.length(), pattern_) == 0;
+        case MATCH_REGEX:
+            return std::regex_search(descriptor, regex_);
+        case MATCH_INSTANCEOF: {
+            art::mirror::Class super = clazz.GetSuperClass();
+            while (super.Ptr()) {
+                if (cache_->GetDescriptor(super) == pattern_)
+                    return true;
+                super = super.GetSuperClass();
+            }
+
+            art::mirror::IfTable& iftable = clazz.GetIfTable();
+            int32_t ifcount = iftable.Count();
+            for (int i = 0; i < ifcount; ++i) {
+                art::mirror::Class interface = iftable.GetInterface(i);
+                if (cache_->GetDescriptor(interface) == pattern_)
+                    return true;
+            }
+        } break;
+    }
+    return false;
+}
+
+bool SearchCommand::Matcher::Match(art::mirror::Class& clazz) {
+    {
+        std::shared_lock<std::shared_mutex> guard(lock_);
+        auto it = verdicts_.find(clazz.Ptr());
+        if (it != verdicts_.end())
+            return it->second;
+    }
+
+    bool verdict = Evaluate(clazz);
+    std::unique_lock<std::shared_mutex> guard(lock_);
+    verdicts_[clazz.Ptr()] = verdict;
+    return verdict;
+}
+
+bool SearchCommand::Matcher::MatchClassObject(art::mirror::Class& clazz) {
+    if (mode_ != MATCH_INSTANCEOF)
+        return Match(clazz);
+
+    if (cache_->GetDescriptor(clazz) == pattern_)
+        return true;
+
+    {
+        std::shared_lock<std::shared_mutex> guard(lock_);
+        if (class_verdict_ >= 0)
+            return class_verdict_;
+    }
+
+    // every class object has the same klass, java.lang.Class.
+    art::mirror::Class java_lang_class = clazz.GetClass();
+    bool verdict = Evaluate(java_lang_class);
+    std::unique_lock<std::shared_mutex> guard(lock_);
+    class_verdict_ = verdict;
+    return verdict;
+}
+
+bool SearchCommand::SearchObjects(SearchCommand::Result& result, art::mirror::Object& object) {
+    bool is_class = class_info->GetClassInfoOf(object).IsClass();
+    int mask = is_class ? SEARCH_CLASS : SEARCH_OBJECT;
     if (!(type_flag & mask))
         return false;
 
-    std::string descriptor;
     art::mirror::Class thiz = 0x0;
-    if (object.IsClass()) {
+    if (is_class) {
         thiz = object;
     } else {
         thiz = object.GetClass();
     }
-    descriptor = thiz.PrettyDescriptor();
-
-    java::lang::Object java = object;
-    if (regex && std::regex_search(descriptor, std::regex(classsname))
-            || descriptor == classsname
-            || (instof && java.instanceof(classsname))) {
-        total_objects++;
-        LOGI("[%ld] " ANSI_COLOR_LIGHTYELLOW  "0x%lx" ANSI_COLOR_LIGHTCYAN " %s\n" ANSI_COLOR_RESET,
-                total_objects, object.Ptr(), descriptor.c_str());
-        if (show) {
-            int argc = 2;
-            std::string address = Utils::ToHex(object.Ptr());
-            char* argv[3] = {
-                const_cast<char*>("p"),
-                const_cast<char*>(address.c_str()),
-                const_cast<char*>(""),};
-            if (format_hex) {
-                argc++;
-                argv[2] = const_cast<char*>("--hex");
-            }
-            CommandManager::Execute(argv[0], argc, argv);
+
+    bool verdict;
+    if (is_class) {
+        // a class object's verdict differs from its instances' under instanceof.
+        verdict = matcher.MatchClassObject(thiz);
+    } else {
+        auto it = result.verdicts.find(thiz.Ptr());
+        if (it != result.verdicts.end()) {
+            verdict = it->second;
+        } else {
+            verdict = matcher.Match(thiz);
+            result.verdicts[thiz.Ptr()] = verdict;
         }
     }
 
-    return false;
+    if (verdict)
+        result.objects.push_back(std::pair<art::mirror::Object, const std::string*>(object, &class_info->GetDescriptor(thiz)));
+    return verdict;
+}
+
+void SearchCommand::ShowObject(art::mirror::Object& object, const std::string& descriptor) {
+    total_objects++;
+    LOGI("[%ld] " ANSI_COLOR_LIGHTYELLOW  "0x%lx" ANSI_COLOR_LIGHTCYAN " %s\n" ANSI_COLOR_RESET,
+            total_objects, object.Ptr(), descriptor.c_str());
+    if (show) {
+        int argc = 2;
+        std::string address = Utils::ToHex(object.Ptr());
+        char* argv[3] = {
+            const_cast<char*>("p"),
+            const_cast<char*>(address.c_str()),
+            const_cast<char*>(""),};
+        if (format_hex) {
+            argc++;
+            argv[2] = const_cast<char*>("--hex");
+        }
+        CommandManager::Execute(argv[0], argc, argv);
+    }
 }
 
 void SearchCommand::usage() {
     LOGI("Usage: search <CLASSNAME> [OPTION..] [TYPE]\n");
     LOGI("Option:\n");
     LOGI("    -r, --regex        regular expression search\n");
+    LOGI("                       a CLASSNAME ending with '*' is a prefix search\n");
     LOGI("    -i, --instanceof   search by instance of class\n");
     LOGI("    -o, --object       only search object\n");
     LOGI("    -c, --class        only search class\n");
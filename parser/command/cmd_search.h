@@ -19,7 +19,13 @@
 
 #include "command/command.h"
 #include "runtime/mirror/object.h"
+#include "runtime/mirror/class_info.h"
 #include "android.h"
+#include <string>
+#include <vector>
+#include <regex>
+#include <unordered_map>
+#include <shared_mutex>
 
 class SearchCommand : public Command {
 public:
@@ -34,7 +40,44 @@ public:
         return true;
     }
     void usage();
-    bool SearchObjects(const char* classsname, art::mirror::Object& object);
+
+    /*
+     * Pattern compiled once, the verdict of each Class is evaluated once and
+     * memoized, objects only look up the verdict of their class.
+     */
+    class Matcher {
+    public:
+        static constexpr int MATCH_LITERAL = 0;
+        static constexpr int MATCH_PREFIX = 1;
+        static constexpr int MATCH_REGEX = 2;
+        static constexpr int MATCH_INSTANCEOF = 3;
+
+        void Compile(const char* pattern, int mode, art::mirror::ClassInfoCache* cache);
+        bool Match(art::mirror::Class& clazz);
+        // clazz is a class object itself, instanceof tests java.lang.Class.
+        bool MatchClassObject(art::mirror::Class& clazz);
+    private:
+        bool Evaluate(art::mirror::Class& clazz);
+
+        int mode_;
+        std::string pattern_;
+        std::regex regex_;
+        art::mirror::ClassInfoCache* cache_;
+        std::shared_mutex lock_;
+        std::unordered_map<uint32_t, bool> verdicts_;
+        // -1 until the first class object, then instanceof java.lang.Class.
+        int class_verdict_;
+    };
+
+    class Result {
+    public:
+        // partition local verdicts in front of the shared matcher.
+        std::unordered_map<uint32_t, bool> verdicts;
+        std::vector<std::pair<art::mirror::Object, const std::string*>> objects;
+    };
+
+    bool SearchObjects(Result& result, art::mirror::Object& object);
+    void ShowObject(art::mirror::Object& object, const std::string& descriptor);
 private:
     uint64_t total_objects;
     int type_flag;
@@ -43,6 +86,8 @@ private:
     bool instof;
     bool show;
     bool format_hex;
+    art::mirror::ClassInfoCache* class_info;
+    Matcher matcher;
 };
 
 #endif // PARSER_COMMAND_CMD_SEARCH_H_
@@ -16,6 +16,7 @@
 
 #include "logger/log.h"
 #include "runtime/mirror/class.h"
+#include "runtime/runtime.h"
 #include "command/command_manager.h"
 #include "command/cmd_top.h"
 #include "common/exception.h"
@@ -29,6 +30,7 @@
 #include <sstream>
 #include <regex>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 int TopCommand::main(int argc, char* const argv[]) {
@@ -50,6 +52,7 @@ int TopCommand::main(int argc, char* const argv[]) {
         {"alloc",      no_argument,       0,  'a'},
         {"shallow",    no_argument,       0,  's'},
         {"native",     no_argument,       0,  'n'},
+        {"retained",   no_argument,       0,  'r'},
         {"display",    no_argument,       0,  'd'},
         {"app",        no_argument,       0,   0 },
         {"zygote",     no_argument,       0,   1 },
@@ -59,7 +62,7 @@ int TopCommand::main(int argc, char* const argv[]) {
         {"weak",       no_argument,       0,   5 },
     };
 
-    while ((opt = getopt_long(argc, argv, "asnd",
+    while ((opt = getopt_long(argc, argv, "asnrd",
                 long_options, &option_index)) != -1) {
         switch (opt) {
             case 'a':
@@ -71,6 +74,9 @@ int TopCommand::main(int argc, char* const argv[]) {
             case 'n':
                 order = ORDERBY_NATIVE;
                 break;
+            case 'r':
+                order = ORDERBY_RETAINED;
+                break;
             case 'd':
                 show = true;
                 break;
@@ -101,42 +107,25 @@ int TopCommand::main(int argc, char* const argv[]) {
         obj_each_flags |= Android::EACH_IMAGE_OBJECTS;
         obj_each_flags |= Android::EACH_FAKE_OBJECTS;
     }
-    std::map<art::mirror::Class, TopCommand::Pair> classes;
-    art::mirror::Class cleaner = 0;
-    std::vector<art::mirror::Object> cleaners;
+    TopCommand::Stats total;
+    std::map<art::mirror::Class, TopCommand::Pair>& classes = total.classes;
+    std::vector<art::mirror::Object>& cleaners = total.cleaners;
     auto callback = [&](art::mirror::Object& object) -> bool {
-        if (object.IsClass())
-            return false;
-
-        art::mirror::Class thiz = object.GetClass();
-        if (!cleaner.Ptr()) {
-            if (thiz.PrettyDescriptor() == "sun.misc.Cleaner") {
-                cleaner = thiz;
-                cleaners.push_back(object);
-            }
-        } else if (cleaner == thiz) {
-            cleaners.push_back(object);
-        }
-
-        auto it = classes.find(thiz.Ptr());
-        if (it == classes.end()) {
-            TopCommand::Pair pair = {
-                .alloc_count = 1,
-                .shallow_size = object.SizeOf(),
-            };
-            classes.insert(std::pair<art::mirror::Class, TopCommand::Pair>(thiz, pair));
-        } else {
-            TopCommand::Pair& pair = it->second;
-            pair.alloc_count += 1;
-            pair.shallow_size += object.SizeOf();
+        return Statistics(total, object);
+    };
+    auto merge = [&](TopCommand::Stats& stats) {
+        for (const auto& value : stats.classes) {
+            TopCommand::Pair& pair = classes[value.first];
+            pair.info = value.second.info;
+            pair.alloc_count += value.second.alloc_count;
+            pair.shallow_size += value.second.shallow_size;
         }
-
-        return false;
+        cleaners.insert(cleaners.end(), stats.cleaners.begin(), stats.cleaners.end());
     };
 
     try {
         if (!ref_each_flags) {
-            Android::ForeachObjects(callback, obj_each_flags, false);
+            Android::ParallelForeachObjects<TopCommand::Stats>(Statistics, merge, obj_each_flags, false);
         } else {
             Android::ForeachReferences(callback, ref_each_flags);
         }
@@ -144,15 +133,30 @@ int TopCommand::main(int argc, char* const argv[]) {
         LOGW("The statistical process was interrupted!\n");
     }
 
-    LOGI(ANSI_COLOR_LIGHTRED "Address       Allocations      ShallowSize        NativeSize     %s\n" ANSI_COLOR_RESET, show ? "ClassName" : "");
+    bool retained = order == ORDERBY_RETAINED;
+    if (retained) {
+        // whole heap dominator tree, shared by all filters.
+        std::unordered_map<uint32_t, uint64_t>& sizes =
+                art::Runtime::Current().GetHeap().GetHeapDominator().GetClassRetainedSizes();
+        for (auto& value : classes) {
+            auto it = sizes.find(value.first.Ptr());
+            if (it != sizes.end())
+                value.second.retained_size = it->second;
+        }
+    }
+
+    LOGI(ANSI_COLOR_LIGHTRED "Address       Allocations      ShallowSize        NativeSize     %s%s\n" ANSI_COLOR_RESET,
+         retained ? "RetainedSize     " : "", show ? "ClassName" : "");
     art::mirror::Class cur_max_thiz = 0;
     TopCommand::Pair cur_max_pair = {
         .alloc_count = 0,
         .shallow_size = 0,
         .native_size = 0,
+        .retained_size = 0,
+        .info = nullptr,
     };
 
-    for (int i = 0; i < cleaners.size(); i++) {
+    for (size_t i = 0; i < cleaners.size(); i++) {
         sun::misc::Cleaner cleaner = cleaners[i];
         java::lang::Object referent = cleaner.getReferent();
 
@@ -218,30 +222,75 @@ int TopCommand::main(int argc, char* const argv[]) {
                        cur_max_pair = pair;
                    }
                 } break;
+                case ORDERBY_RETAINED: {
+                   if (pair.retained_size >= cur_max_pair.retained_size) {
+                       cur_max_thiz = thiz;
+                       cur_max_pair = pair;
+                   }
+                } break;
             }
         }
 
         if (!cur_max_thiz.Ptr())
             break;
 
-        LOGI(ANSI_COLOR_LIGHTYELLOW "0x%08lx" ANSI_COLOR_RESET "       " "%8ld      " "%11ld       " "%11ld     " ANSI_COLOR_LIGHTCYAN "%s\n" ANSI_COLOR_RESET,
+        std::string retained_column;
+        if (retained) {
+            char column[32];
+            snprintf(column, sizeof(column), "%12ld     ", cur_max_pair.retained_size);
+            retained_column = column;
+        }
+
+        LOGI(ANSI_COLOR_LIGHTYELLOW "0x%08lx" ANSI_COLOR_RESET "       " "%8ld      " "%11ld       " "%11ld     " "%s" ANSI_COLOR_LIGHTCYAN "%s\n" ANSI_COLOR_RESET,
              cur_max_thiz.Ptr(), cur_max_pair.alloc_count,
-             cur_max_pair.shallow_size, cur_max_pair.native_size,
-             show ? cur_max_thiz.PrettyDescriptor().c_str() : "");
+             cur_max_pair.shallow_size, cur_max_pair.native_size, retained_column.c_str(),
+             show ? art::Runtime::Current().GetHeap().GetClassInfoCache().GetDescriptor(cur_max_thiz).c_str() : "");
 
         classes.erase(cur_max_thiz);
         cur_max_thiz = 0;
-        cur_max_pair = {0, 0, 0};
+        cur_max_pair = {0, 0, 0, 0, nullptr};
     }
     return 0;
 }
 
+bool TopCommand::Statistics(TopCommand::Stats& stats, art::mirror::Object& object) {
+    if (object.IsClass())
+        return false;
+
+    art::mirror::Class thiz = object.GetClass();
+    auto it = stats.classes.find(thiz);
+    if (it == stats.classes.end()) {
+        const art::mirror::ClassInfo& info = art::Runtime::Current().GetHeap().GetClassInfoCache().GetClassInfo(thiz);
+        TopCommand::Pair pair = {
+            .alloc_count = 1,
+            .shallow_size = info.SizeOf(object),
+            .native_size = 0,
+            .retained_size = 0,
+            .info = &info,
+        };
+        stats.classes.insert(std::pair<art::mirror::Class, TopCommand::Pair>(thiz, pair));
+
+        // only check descriptor on first seen class.
+        if (!stats.cleaner.Ptr() && info.descriptor == "sun.misc.Cleaner")
+            stats.cleaner = thiz;
+    } else {
+        TopCommand::Pair& pair = it->second;
+        pair.alloc_count += 1;
+        pair.shallow_size += pair.info->SizeOf(object);
+    }
+
+    if (stats.cleaner.Ptr() && stats.cleaner == thiz)
+        stats.cleaners.push_back(object);
+    return false;
+}
+
 void TopCommand::usage() {
     LOGI("Usage: top <NUM> [OPTION] [TYPE]\n");
     LOGI("Option:\n");
     LOGI("    -a, --alloc     order by allocation\n");
     LOGI("    -s, --shallow   order by shallow\n");
     LOGI("    -n, --native    order by native\n");
+    LOGI("    -r, --retained  order by retained (dominator tree of the whole heap)\n");
     LOGI("    -d, --display   show class name\n");
     LOGI("Type: {--app, --zygote, --image, --fake}\n");
     ENTER();
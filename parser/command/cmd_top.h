@@ -19,13 +19,18 @@
 
 #include "command/command.h"
 #include "runtime/mirror/object.h"
+#include "runtime/mirror/class.h"
+#include "runtime/mirror/class_info.h"
 #include "android.h"
+#include <map>
+#include <vector>
 
 class TopCommand : public Command {
 public:
     static constexpr int ORDERBY_ALLOC = 1 << 0;
     static constexpr int ORDERBY_SHALLOW = 1 << 1;
     static constexpr int ORDERBY_NATIVE = 1 << 2;
+    static constexpr int ORDERBY_RETAINED = 1 << 3;
 
     TopCommand() : Command("top") {}
     ~TopCommand() {}
@@ -41,7 +46,17 @@ public:
         uint64_t alloc_count;
         uint64_t shallow_size;
         uint64_t native_size;
+        uint64_t retained_size;
+        const art::mirror::ClassInfo* info;
     };
+
+    class Stats {
+    public:
+        std::map<art::mirror::Class, Pair> classes;
+        art::mirror::Class cleaner = 0;
+        std::vector<art::mirror::Object> cleaners;
+    };
+    static bool Statistics(Stats& stats, art::mirror::Object& object);
 private:
     int num;
     int order;
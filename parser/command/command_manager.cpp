@@ -37,6 +37,8 @@
 #include "command/cmd_search.h"
 #include "command/cmd_class.h"
 #include "command/cmd_top.h"
+#include "command/cmd_retained.h"
+#include "command/cmd_path.h"
 #include "command/cmd_space.h"
 #include "command/cmd_dex.h"
 #include "command/cmd_method.h"
@@ -95,6 +97,8 @@ void CommandManager::Init() {
     CommandManager::PushInlineCommand(new SearchCommand());
     CommandManager::PushInlineCommand(new ClassCommand());
     CommandManager::PushInlineCommand(new TopCommand());
+    CommandManager::PushInlineCommand(new RetainedCommand());
+    CommandManager::PushInlineCommand(new PathCommand());
     CommandManager::PushInlineCommand(new SpaceCommand());
     CommandManager::PushInlineCommand(new DexCommand());
     CommandManager::PushInlineCommand(new MethodCommand());
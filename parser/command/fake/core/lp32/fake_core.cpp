@@ -22,9 +22,19 @@
 #include <stdio.h>
 #include <string.h>
 #include <linux/elf.h>
+#include <algorithm>
 
 namespace lp32 {
 
+// copy through a user buffer, write(2) can't fault in a compressed core chunk.
+static void WriteSegment(FILE* fp, uint64_t addr, uint64_t size, uint8_t* buf) {
+    for (uint64_t off = 0; off < size; off += ELF_PAGE_SIZE) {
+        uint64_t len = std::min<uint64_t>(ELF_PAGE_SIZE, size - off);
+        memcpy(buf, reinterpret_cast<void *>(addr + off), len);
+        fwrite(buf, len, 1, fp);
+    }
+}
+
 int FakeCore::execute(const char* output) {
     if (!CoreApi::IsReady())
         return -1;
@@ -87,11 +97,12 @@ int FakeCore::execute(const char* output) {
     // Write Segment
     uint8_t* zero_buf = (uint8_t*)malloc(ELF_PAGE_SIZE);
     memset(zero_buf, 0x0, ELF_PAGE_SIZE);
+    uint8_t* page_buf = (uint8_t*)malloc(ELF_PAGE_SIZE);
 
     // reset num
     num = 0;
     for (const auto& note : notes) {
-        fwrite(reinterpret_cast<void *>(note->begin()), tmp[num].p_filesz, 1, fp);
+        WriteSegment(fp, note->begin(), tmp[num].p_filesz, page_buf);
         current_filesz += tmp[num].p_filesz;
         if (!IS_ALIGNED(current_filesz, ELF_PAGE_SIZE)) {
             uint32_t aliged_size = RoundUp(current_filesz, ELF_PAGE_SIZE) - current_filesz;
@@ -109,12 +120,13 @@ int FakeCore::execute(const char* output) {
 
         if (block->isValid()) {
             current_filesz += tmp[num].p_filesz;
-            fwrite(reinterpret_cast<void *>(block->begin()), tmp[num].p_filesz, 1, fp);
+            WriteSegment(fp, block->begin(), tmp[num].p_filesz, page_buf);
         }
         ++num;
     }
 
     free(zero_buf);
+    free(page_buf);
     free(tmp);
     fclose(fp);
     LOGI("FakeCore: saved [%s]\n", output);
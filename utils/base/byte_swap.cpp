@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "base/byte_swap.h"
+#include <string.h>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+template<typename T>
+static inline void CopyScalar(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        T value;
+        memcpy(&value, src + i * sizeof(T), sizeof(T));
+        if constexpr (sizeof(T) == 2) {
+            value = __builtin_bswap16(value);
+        } else if constexpr (sizeof(T) == 4) {
+            value = __builtin_bswap32(value);
+        } else {
+            value = __builtin_bswap64(value);
+        }
+        memcpy(dst + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+#if defined(__aarch64__)
+
+template<typename T>
+static inline void Copy(uint8_t* dst, const uint8_t* src, size_t count) {
+    size_t bytes = count * sizeof(T);
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        if constexpr (sizeof(T) == 2) {
+            v = vrev16q_u8(v);
+        } else if constexpr (sizeof(T) == 4) {
+            v = vrev32q_u8(v);
+        } else {
+            v = vrev64q_u8(v);
+        }
+        vst1q_u8(dst + i, v);
+    }
+    CopyScalar<T>(dst + i, src + i, (bytes - i) / sizeof(T));
+}
+
+#elif defined(__x86_64__)
+
+template<typename T>
+__attribute__((target("ssse3")))
+static void CopySsse3(uint8_t* dst, const uint8_t* src, size_t count) {
+    __m128i mask;
+    if constexpr (sizeof(T) == 2) {
+        mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    } else if constexpr (sizeof(T) == 4) {
+        mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    } else {
+        mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    }
+
+    size_t bytes = count * sizeof(T);
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+    CopyScalar<T>(dst + i, src + i, (bytes - i) / sizeof(T));
+}
+
+static bool HasSsse3() {
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+template<typename T>
+static inline void Copy(uint8_t* dst, const uint8_t* src, size_t count) {
+    if (HasSsse3()) {
+        CopySsse3<T>(dst, src, count);
+    } else {
+        CopyScalar<T>(dst, src, count);
+    }
+}
+
+#else
+
+template<typename T>
+static inline void Copy(uint8_t* dst, const uint8_t* src, size_t count) {
+    CopyScalar<T>(dst, src, count);
+}
+
+#endif
+
+void ByteSwap::CopyU2(uint8_t* dst, const void* src, size_t count) {
+    Copy<uint16_t>(dst, reinterpret_cast<const uint8_t*>(src), count);
+}
+
+void ByteSwap::CopyU4(uint8_t* dst, const void* src, size_t count) {
+    Copy<uint32_t>(dst, reinterpret_cast<const uint8_t*>(src), count);
+}
+
+void ByteSwap::CopyU8(uint8_t* dst, const void* src, size_t count) {
+    Copy<uint64_t>(dst, reinterpret_cast<const uint8_t*>(src), count);
+}
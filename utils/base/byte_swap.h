@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UTILS_BASE_BYTE_SWAP_H_
+#define UTILS_BASE_BYTE_SWAP_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+
+class ByteSwap {
+public:
+    /*
+     * Copy count host (little endian) elements from src into dst as big endian,
+     * src and dst may be unaligned and must not overlap.
+     */
+    static void CopyU2(uint8_t* dst, const void* src, size_t count);
+    static void CopyU4(uint8_t* dst, const void* src, size_t count);
+    static void CopyU8(uint8_t* dst, const void* src, size_t count);
+};
+
+#endif // UTILS_BASE_BYTE_SWAP_H_
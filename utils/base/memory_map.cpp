@@ -16,12 +16,15 @@
 
 #include "base/memory_map.h"
 #include "base/utils.h"
+#include "zip/decompressor.h"
+#include "zip/chunk_cache.h"
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
 #include <iostream>
+#include <algorithm>
 
 MemoryMap* MemoryMap::MmapFile(const char* file) {
     return MmapFile(file, 0);
@@ -63,6 +66,8 @@ MemoryMap* MemoryMap::MmapFile(int fd, uint64_t size, uint64_t off) {
         if (mem != MAP_FAILED) {
             uint64_t real_size = std::min(size, sb.st_size - off);
             map = new MemoryMap(mem, size, off, real_size);
+            map->mDev = sb.st_dev;
+            map->mIno = sb.st_ino;
         }
     }
     return map;
@@ -86,21 +91,77 @@ MemoryMap* MemoryMap::MmapZeroMem(uint64_t size) {
     MemoryMap *map = nullptr;
     void* mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, 0, 0);
     if (mem != MAP_FAILED) {
+        // anonymous pages are zero filled on first touch.
         map = new MemoryMap(mem, size, 0, size);
-        memset(mem, 0x0, size);
     }
     return map;
 }
 
+MemoryMap* MemoryMap::MmapCompressedFile(const char* file) {
+    std::unique_ptr<Decompressor> source = Decompressor::Open(file);
+    ChunkCache* cache = ChunkCache::Create(source);
+    if (!cache)
+        return nullptr;
+
+    MemoryMap* map = new MemoryMap(cache->data(), cache->size(), 0, cache->size());
+    map->mCache = cache;
+    map->mName = file;
+    return map;
+}
+
+MemoryMap* MemoryMap::CopyOnWrite(uint64_t addr, uint64_t size, uint64_t realSize) {
+    if (mCache || mName.empty() || addr < data() || addr >= data() + mSize)
+        return nullptr;
+
+    uint64_t page_size = sysconf(_SC_PAGESIZE);
+    uint64_t off = mOffset + (addr - data());
+    if (off % page_size)
+        return nullptr;
+
+    realSize = std::min(realSize, std::min(size, mMaxSize - std::min(mMaxSize, addr - data())));
+    int fd = open(mName.c_str(), O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+
+    // replaced or renamed since it was mapped, let the caller copy instead.
+    struct stat sb;
+    if (fstat(fd, &sb) == -1 || sb.st_dev != mDev || sb.st_ino != mIno) {
+        close(fd);
+        return nullptr;
+    }
+
+    MemoryMap *map = nullptr;
+    void* mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (mem != MAP_FAILED) {
+        // whole pages share the file, a partial last page is copied.
+        uint64_t file_size = realSize - (realSize % page_size);
+        bool success = !file_size || mmap(mem, file_size, PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_FIXED, fd, off) != MAP_FAILED;
+        if (success && file_size < realSize) {
+            success = pread(fd, reinterpret_cast<uint8_t *>(mem) + file_size, realSize - file_size,
+                            off + file_size) == static_cast<ssize_t>(realSize - file_size);
+        }
+        if (success) {
+            map = new MemoryMap(mem, size, 0, size);
+        } else {
+            munmap(mem, size);
+        }
+    }
+    close(fd);
+    return map;
+}
+
 uint32_t MemoryMap::GetCRC32() {
     if (!mCRC32) {
-        mCRC32 = Utils::CRC32(reinterpret_cast<uint8_t *>(mBegin), mSize);
+        mCRC32 = Utils::ParallelCRC32(reinterpret_cast<uint8_t *>(mBegin), mSize);
     }
     return mCRC32;
 }
 
 MemoryMap::~MemoryMap() {
-    if (mBegin != MAP_FAILED) {
+    if (mCache) {
+        delete mCache;
+    } else if (mBegin != MAP_FAILED) {
         munmap(mBegin, mSize);
     }
 }
@@ -21,6 +21,8 @@
 #include <sys/types.h>
 #include <string>
 
+class ChunkCache;
+
 class MemoryMap {
 public:
     static MemoryMap* MmapFile(const char* file);
@@ -29,6 +31,16 @@ public:
     static MemoryMap* MmapMem(uint64_t addr, uint64_t size);
     static MemoryMap* MmapMem(uint64_t addr, uint64_t size, uint64_t realSize);
     static MemoryMap* MmapZeroMem(uint64_t size);
+    // .gz or .zst file, decompressed on demand through a bounded chunk cache.
+    static MemoryMap* MmapCompressedFile(const char* file);
+    /*
+     * Writable private view of [addr, addr + size) inside this file map,
+     * the kernel copies a page only once it is written and untouched pages
+     * keep reading the file, bytes past realSize read as zero.
+     * nullptr if this is not a plain file map, addr is not page aligned in it,
+     * or the file at this name is no longer the one first mapped.
+     */
+    MemoryMap* CopyOnWrite(uint64_t addr, uint64_t size, uint64_t realSize);
     inline uint64_t data() { return reinterpret_cast<uint64_t>(mBegin); }
     inline uint64_t size() { return mSize; }
     inline uint64_t offset() { return mOffset; }
@@ -39,7 +51,8 @@ public:
 private:
     static MemoryMap* MmapFile(int fd, uint64_t size, uint64_t off);
     MemoryMap(void *m, uint64_t s, uint64_t off, uint64_t max)
-        : mBegin(m), mSize(s), mOffset(off), mCRC32(0x0), mMaxSize(max) {}
+        : mBegin(m), mSize(s), mOffset(off), mCRC32(0x0), mMaxSize(max), mCache(nullptr),
+          mDev(0), mIno(0) {}
 
     std::string mName;
     void* mBegin;
@@ -47,6 +60,10 @@ private:
     uint64_t mOffset;
     uint32_t mCRC32;
     uint64_t mMaxSize;
+    ChunkCache* mCache;
+    // identity of the mapped file, CopyOnWrite reopens it by name.
+    dev_t mDev;
+    ino_t mIno;
 };
 
 #endif  // UTILS_BASE_MEMORY_MAP_H_
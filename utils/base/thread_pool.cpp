@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logger/log.h"
+#include "base/thread_pool.h"
+#include <exception>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+uint32_t ThreadPool::kWorkers = 0;
+
+uint32_t ThreadPool::GetWorkers() {
+    if (kWorkers)
+        return kWorkers;
+
+    uint32_t num = std::thread::hardware_concurrency();
+    return num ? num : 1;
+}
+
+static void RunTask(std::function<void (uint32_t idx)>& task, uint32_t idx) {
+    try {
+        task(idx);
+    } catch (...) {
+        LOGW("Task(%d) was interrupted!\n", idx);
+    }
+}
+
+void ThreadPool::ForEach(uint32_t count, std::function<void (uint32_t idx)> task) {
+    ForEach(count, task, nullptr);
+}
+
+void ThreadPool::ForEach(uint32_t count, std::function<void (uint32_t idx)> task,
+                                         std::function<void (uint32_t idx)> done) {
+    uint32_t workers = GetWorkers();
+    if (workers > count)
+        workers = count;
+
+    if (workers <= 1) {
+        for (uint32_t idx = 0; idx < count; ++idx) {
+            RunTask(task, idx);
+            if (done) done(idx);
+        }
+        return;
+    }
+
+    // with done, workers run at most window tasks ahead of the merge,
+    // so finished but unmerged results can't pile up behind a slow task.
+    uint32_t window = workers * 2;
+    uint32_t next = 0;
+    uint32_t merged = 0;
+    std::vector<bool> finished(count, false);
+    std::mutex lock;
+    std::condition_variable cond;
+
+    auto run = [&]() {
+        while (true) {
+            uint32_t idx;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                if (done) cond.wait(guard, [&] { return next >= count || next < merged + window; });
+                if (next >= count)
+                    break;
+                idx = next++;
+            }
+            RunTask(task, idx);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                finished[idx] = true;
+            }
+            cond.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < workers; ++i)
+        threads.emplace_back(run);
+
+    std::exception_ptr error = nullptr;
+    for (uint32_t idx = 0; idx < count; ++idx) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            cond.wait(guard, [&] { return finished[idx]; });
+        }
+        try {
+            if (done) done(idx);
+        } catch (...) {
+            // stop workers first, rethrow on the caller thread.
+            error = std::current_exception();
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                next = count;
+            }
+            cond.notify_all();
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            merged = idx + 1;
+        }
+        cond.notify_all();
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_BASE_THREAD_POOL_H_
+#define UTILS_BASE_THREAD_POOL_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <functional>
+
+class ThreadPool {
+public:
+    static uint32_t GetWorkers();
+    /*
+     * 0 restore default (hardware concurrency)
+     * 1 run tasks on the caller thread
+     */
+    static void SetWorkers(uint32_t num) { kWorkers = num; }
+
+    /*
+     * task(0) ... task(count - 1) run on workers in any order,
+     * done(idx) run on the caller thread in idx order, as soon as
+     * task(0) ... task(idx) are all finished. Workers don't start task(idx) until
+     * done(idx - 2 * workers) returned, bounding the unmerged results.
+     */
+    static void ForEach(uint32_t count, std::function<void (uint32_t idx)> task);
+    static void ForEach(uint32_t count, std::function<void (uint32_t idx)> task,
+                                        std::function<void (uint32_t idx)> done);
+private:
+    static uint32_t kWorkers;
+};
+
+#endif // UTILS_BASE_THREAD_POOL_H_
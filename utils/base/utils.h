@@ -31,6 +31,8 @@ public:
     static std::string ToHex(uint64_t value);
     static uint32_t CRC32(uint8_t* data, uint32_t len);
     static uint64_t CRC64(uint8_t* data, uint64_t len);
+    static uint32_t CRC32Combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+    static uint32_t ParallelCRC32(uint8_t* data, uint64_t len);
 };
 
 #endif // UTILS_BASE_UTILS_H_
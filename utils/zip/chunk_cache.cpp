@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "logger/log.h"
+#include "zip/chunk_cache.h"
+#include "base/thread_pool.h"
+#include <linux/userfaultfd.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <inttypes.h>
+#include <algorithm>
+
+#ifndef UFFD_USER_MODE_ONLY
+#define UFFD_USER_MODE_ONLY 1
+#endif
+
+ChunkCache* ChunkCache::Create(std::unique_ptr<Decompressor>& source) {
+    if (!source || !source->size())
+        return nullptr;
+
+    // only faults from user mode, which is all an unprivileged process may handle.
+    int uffd = syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY);
+    if (uffd == -1 && errno == EINVAL)
+        uffd = syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK);
+    if (uffd == -1) {
+        LOGE("userfaultfd not available (%s), decompress the core first.\n", strerror(errno));
+        return nullptr;
+    }
+
+    struct uffdio_api api;
+    memset(&api, 0, sizeof(api));
+    api.api = UFFD_API;
+    if (ioctl(uffd, UFFDIO_API, &api) == -1) {
+        LOGE("userfaultfd api (%s).\n", strerror(errno));
+        close(uffd);
+        return nullptr;
+    }
+
+    uint64_t chunks = (source->size() + kChunkSize - 1) / kChunkSize;
+    void* mem = mmap(NULL, chunks * kChunkSize, PROT_READ,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mem == MAP_FAILED) {
+        close(uffd);
+        return nullptr;
+    }
+
+    struct uffdio_register reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.range.start = reinterpret_cast<uint64_t>(mem);
+    reg.range.len = chunks * kChunkSize;
+    reg.mode = UFFDIO_REGISTER_MODE_MISSING;
+    int stop = eventfd(0, EFD_CLOEXEC);
+    if (ioctl(uffd, UFFDIO_REGISTER, &reg) == -1 || stop == -1) {
+        LOGE("userfaultfd register (%s).\n", strerror(errno));
+        if (stop != -1) close(stop);
+        munmap(mem, chunks * kChunkSize);
+        close(uffd);
+        return nullptr;
+    }
+
+    // every worker may hold a chunk or two mapped while walking the heap.
+    uint32_t capacity = std::max<uint64_t>(kCacheSize / kChunkSize, ThreadPool::GetWorkers() * 8);
+    return new ChunkCache(source, uffd, stop, reinterpret_cast<uint8_t *>(mem), chunks, capacity);
+}
+
+ChunkCache::ChunkCache(std::unique_ptr<Decompressor>& source, int uffd, int stop,
+                       uint8_t* begin, uint64_t chunks, uint32_t capacity)
+        : source_(std::move(source)), uffd_(uffd), stop_(stop), begin_(begin),
+          chunks_(chunks), capacity_(capacity), state_(chunks, STATE_NONE),
+          data_(chunks), where_(chunks) {
+    // one decode per handler runs at a time, faults on other chunks don't queue behind it.
+    uint32_t workers = std::max<uint32_t>(ThreadPool::GetWorkers(), 1);
+    for (uint32_t i = 0; i < workers; ++i)
+        handlers_.emplace_back(&ChunkCache::Handler, this);
+}
+
+ChunkCache::~ChunkCache() {
+    eventfd_write(stop_, 1);
+    for (std::thread& handler : handlers_)
+        handler.join();
+    close(stop_);
+    close(uffd_);
+    munmap(begin_, chunks_ * kChunkSize);
+}
+
+void ChunkCache::Handler() {
+    struct pollfd fds[2];
+    fds[0] = { uffd_, POLLIN, 0 };
+    fds[1] = { stop_, POLLIN, 0 };
+    while (true) {
+        if (poll(fds, 2, -1) == -1) {
+            if (errno == EINTR)
+                continue;
+            LOGE("userfaultfd poll (%s).\n", strerror(errno));
+            break;
+        }
+        if (fds[1].revents)
+            break;
+
+        // another handler may have taken the message.
+        struct uffd_msg msg;
+        if (read(uffd_, &msg, sizeof(msg)) != sizeof(msg))
+            continue;
+        if (msg.event == UFFD_EVENT_PAGEFAULT)
+            Fault(msg.arg.pagefault.address);
+    }
+}
+
+void ChunkCache::Fault(uint64_t addr) {
+    uint64_t idx = (addr - reinterpret_cast<uint64_t>(begin_)) / kChunkSize;
+    std::unique_lock<std::mutex> guard(lock_);
+    while (state_[idx] == STATE_LOADING)
+        cond_.wait(guard);
+
+    if (state_[idx] == STATE_ACTIVE) {
+        // filled by another handler after this fault was raised.
+        active_.splice(active_.begin(), active_, where_[idx]);
+        guard.unlock();
+        uint64_t page_size = sysconf(_SC_PAGESIZE);
+        Wake(addr & ~(page_size - 1), page_size);
+        return;
+    }
+
+    uint8_t state = state_[idx];
+    if (state == STATE_INACTIVE)
+        inactive_.erase(where_[idx]);
+    state_[idx] = STATE_LOADING;
+    guard.unlock();
+
+    if (state == STATE_NONE) {
+        uint64_t off = idx * kChunkSize;
+        uint64_t length = std::min(kChunkSize, size() - off);
+        // zeroed, so a short or corrupt tail reads as zero.
+        data_[idx].reset(new uint8_t[kChunkSize]());
+        if (!source_->Read(off, data_[idx].get(), length))
+            LOGE("Decompress chunk [%" PRIx64 ", %" PRIx64 ") fail.\n", off, off + length);
+    }
+    Fill(idx);
+
+    guard.lock();
+    state_[idx] = STATE_ACTIVE;
+    active_.push_front(idx);
+    where_[idx] = active_.begin();
+    Balance();
+    guard.unlock();
+    cond_.notify_all();
+}
+
+void ChunkCache::Fill(uint64_t idx) {
+    uint64_t page_size = sysconf(_SC_PAGESIZE);
+    uint64_t target = reinterpret_cast<uint64_t>(begin_) + idx * kChunkSize;
+    uint64_t source = reinterpret_cast<uint64_t>(data_[idx].get());
+    uint64_t off = 0;
+    while (off < kChunkSize) {
+        // wakes every thread waiting on the copied range.
+        struct uffdio_copy copy;
+        copy.dst = target + off;
+        copy.src = source + off;
+        copy.len = kChunkSize - off;
+        copy.mode = 0;
+        copy.copy = 0;
+        if (ioctl(uffd_, UFFDIO_COPY, &copy) == 0)
+            return;
+        if (copy.copy > 0) {
+            off += copy.copy;
+        } else if (errno == EEXIST) {
+            off += page_size;
+        } else if (errno != EAGAIN) {
+            LOGE("Can't map chunk [%" PRIx64 ", %" PRIx64 ") (%s).\n",
+                 idx * kChunkSize, (idx + 1) * kChunkSize, strerror(errno));
+            Wake(target, kChunkSize);
+            return;
+        }
+    }
+}
+
+void ChunkCache::Wake(uint64_t addr, uint64_t length) {
+    struct uffdio_range range;
+    range.start = addr;
+    range.len = length;
+    ioctl(uffd_, UFFDIO_WAKE, &range);
+}
+
+/*
+ * The region can't see loads from a mapped chunk, so recency is kept the
+ * way the kernel does for pages: the most recent quarter stays mapped, older
+ * chunks drop their pages but keep the decoded data, and the next touch
+ * faults, copies it back and moves the chunk to the front. Chunks falling
+ * off the end of the inactive list are freed and decoded again on demand.
+ * A mapped chunk is resident twice, its decoded data and its pages, so it
+ * counts twice against capacity.
+ */
+void ChunkCache::Balance() {
+    while (active_.size() > capacity_ / 4) {
+        uint64_t victim = active_.back();
+        active_.pop_back();
+        madvise(begin_ + victim * kChunkSize, kChunkSize, MADV_DONTNEED);
+        state_[victim] = STATE_INACTIVE;
+        inactive_.push_front(victim);
+        where_[victim] = inactive_.begin();
+    }
+    while (!inactive_.empty() && active_.size() * 2 + inactive_.size() > capacity_) {
+        uint64_t victim = inactive_.back();
+        inactive_.pop_back();
+        data_[victim].reset();
+        state_[victim] = STATE_NONE;
+    }
+}
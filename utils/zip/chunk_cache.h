@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UTILS_ZIP_CHUNK_CACHE_H_
+#define UTILS_ZIP_CHUNK_CACHE_H_
+
+#include "zip/decompressor.h"
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <list>
+#include <vector>
+
+/*
+ * Presents a decompressed stream as one flat read-only region. The region
+ * is registered with userfaultfd, handler threads decode a chunk on its
+ * first touch and copy it in, and at most capacity chunks of memory, decoded
+ * data plus mapped pages, are kept in a least recently used list.
+ * Raw pointers into the region work as with an mmapped file, but pass them
+ * to syscalls only through a user buffer, the kernel won't fault chunks in.
+ */
+class ChunkCache {
+public:
+    // nullptr if the stream is empty or userfaultfd is not available.
+    static ChunkCache* Create(std::unique_ptr<Decompressor>& source);
+    inline uint8_t* data() { return begin_; }
+    inline uint64_t size() { return source_->size(); }
+    ~ChunkCache();
+private:
+    static constexpr uint64_t kChunkSize = 4 * 1024 * 1024;
+    static constexpr uint64_t kCacheSize = 512 * 1024 * 1024;
+    // not decoded.
+    static constexpr uint8_t STATE_NONE = 0;
+    static constexpr uint8_t STATE_LOADING = 1;
+    // decoded, pages dropped from the region.
+    static constexpr uint8_t STATE_INACTIVE = 2;
+    // decoded and mapped.
+    static constexpr uint8_t STATE_ACTIVE = 3;
+
+    ChunkCache(std::unique_ptr<Decompressor>& source, int uffd, int stop,
+               uint8_t* begin, uint64_t chunks, uint32_t capacity);
+    void Handler();
+    void Fault(uint64_t addr);
+    void Fill(uint64_t idx);
+    void Wake(uint64_t addr, uint64_t length);
+    void Balance();
+
+    std::unique_ptr<Decompressor> source_;
+    int uffd_;
+    // eventfd, tells handler threads to exit.
+    int stop_;
+    uint8_t* begin_;
+    uint64_t chunks_;
+    uint32_t capacity_;
+    std::vector<std::thread> handlers_;
+    std::mutex lock_;
+    std::condition_variable cond_;
+    std::vector<uint8_t> state_;
+    std::vector<std::unique_ptr<uint8_t[]>> data_;
+    std::vector<std::list<uint64_t>::iterator> where_;
+    // most recently used first.
+    std::list<uint64_t> active_;
+    std::list<uint64_t> inactive_;
+};
+
+#endif  // UTILS_ZIP_CHUNK_CACHE_H_
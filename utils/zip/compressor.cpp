@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "logger/log.h"
+#include "zip/compressor.h"
+#include <string.h>
+#include <vector>
+
+#if defined(__ZLIB__)
+#include <zlib.h>
+#endif // __ZLIB__
+
+#if defined(__ZSTD__)
+#include <zstd.h>
+#endif // __ZSTD__
+
+static constexpr size_t kCompressChunk = 1024 * 1024;
+
+#if defined(__ZLIB__)
+class GzipCompressor : public Compressor {
+public:
+    GzipCompressor(FILE* fp) : Compressor(fp), out_(kCompressChunk) {
+        memset(&strm_, 0, sizeof(strm_));
+        // 16 + MAX_WBITS, gzip header and trailer instead of zlib.
+        if (deflateInit2(&strm_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                         16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            errors_ = true;
+    }
+    ~GzipCompressor() { deflateEnd(&strm_); }
+
+    bool Write(const uint8_t* buffer, size_t length) override {
+        return Deflate(buffer, length, Z_NO_FLUSH);
+    }
+
+    bool Finish() override {
+        return Deflate(nullptr, 0, Z_FINISH);
+    }
+private:
+    bool Deflate(const uint8_t* buffer, size_t length, int flush) {
+        if (errors_)
+            return false;
+
+        strm_.next_in = const_cast<uint8_t*>(buffer);
+        strm_.avail_in = length;
+        int ret;
+        do {
+            strm_.next_out = out_.data();
+            strm_.avail_out = out_.size();
+            ret = deflate(&strm_, flush);
+            if (ret == Z_STREAM_ERROR) {
+                errors_ = true;
+                return false;
+            }
+            size_t have = out_.size() - strm_.avail_out;
+            if (have && !fwrite(out_.data(), have, 1, fp_)) {
+                errors_ = true;
+                return false;
+            }
+        } while (strm_.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+        return true;
+    }
+
+    z_stream strm_;
+    std::vector<uint8_t> out_;
+};
+#endif // __ZLIB__
+
+#if defined(__ZSTD__)
+class ZstdCompressor : public Compressor {
+public:
+    ZstdCompressor(FILE* fp, int workers) : Compressor(fp), out_(ZSTD_CStreamOutSize()) {
+        cctx_ = ZSTD_createCCtx();
+        if (!cctx_) {
+            errors_ = true;
+            return;
+        }
+        ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+        ZSTD_CCtx_setParameter(cctx_, ZSTD_c_checksumFlag, 1);
+        // ignored by single thread libzstd.
+        if (workers > 1)
+            ZSTD_CCtx_setParameter(cctx_, ZSTD_c_nbWorkers, workers);
+    }
+    ~ZstdCompressor() { if (cctx_) ZSTD_freeCCtx(cctx_); }
+
+    bool Write(const uint8_t* buffer, size_t length) override {
+        return Compress(buffer, length, ZSTD_e_continue);
+    }
+
+    bool Finish() override {
+        return Compress(nullptr, 0, ZSTD_e_end);
+    }
+private:
+    bool Compress(const uint8_t* buffer, size_t length, ZSTD_EndDirective mode) {
+        if (errors_)
+            return false;
+
+        ZSTD_inBuffer input = { buffer, length, 0 };
+        bool finished;
+        do {
+            ZSTD_outBuffer output = { out_.data(), out_.size(), 0 };
+            size_t remaining = ZSTD_compressStream2(cctx_, &output, &input, mode);
+            if (ZSTD_isError(remaining)) {
+                LOGE("zstd compress fail(%s)\n", ZSTD_getErrorName(remaining));
+                errors_ = true;
+                return false;
+            }
+            if (output.pos && !fwrite(out_.data(), output.pos, 1, fp_)) {
+                errors_ = true;
+                return false;
+            }
+            finished = (mode == ZSTD_e_end) ? (remaining == 0) : (input.pos == input.size);
+        } while (!finished);
+        return true;
+    }
+
+    ZSTD_CCtx* cctx_;
+    std::vector<uint8_t> out_;
+};
+#endif // __ZSTD__
+
+bool Compressor::IsSupported(int type) {
+    switch (type) {
+#if defined(__ZLIB__)
+        case TYPE_GZIP:
+            return true;
+#endif // __ZLIB__
+#if defined(__ZSTD__)
+        case TYPE_ZSTD:
+            return true;
+#endif // __ZSTD__
+    }
+    return false;
+}
+
+int Compressor::TypeOf(const char* name) {
+    if (!strcmp(name, "gzip") || !strcmp(name, "gz"))
+        return TYPE_GZIP;
+    if (!strcmp(name, "zstd") || !strcmp(name, "zst"))
+        return TYPE_ZSTD;
+    return TYPE_NONE;
+}
+
+const char* Compressor::Extension(int type) {
+    switch (type) {
+        case TYPE_GZIP:
+            return ".gz";
+        case TYPE_ZSTD:
+            return ".zst";
+    }
+    return "";
+}
+
+std::unique_ptr<Compressor> Compressor::Create(FILE* fp, int type, int workers) {
+    std::unique_ptr<Compressor> compressor;
+    switch (type) {
+#if defined(__ZLIB__)
+        case TYPE_GZIP:
+            compressor = std::make_unique<GzipCompressor>(fp);
+            break;
+#endif // __ZLIB__
+#if defined(__ZSTD__)
+        case TYPE_ZSTD:
+            compressor = std::make_unique<ZstdCompressor>(fp, workers);
+            break;
+#endif // __ZSTD__
+    }
+    return compressor;
+}
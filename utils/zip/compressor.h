@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UTILS_ZIP_COMPRESSOR_H_
+#define UTILS_ZIP_COMPRESSOR_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdio.h>
+#include <memory>
+
+/*
+ * Streaming compressor writing a standard framed file (.gz or .zst),
+ * which can be decompressed on the fly by gzip -dc or zstd -dc.
+ */
+class Compressor {
+public:
+    static constexpr int TYPE_NONE = 0;
+    static constexpr int TYPE_GZIP = 1;
+    static constexpr int TYPE_ZSTD = 2;
+
+    // false if build without zlib or libzstd
+    static bool IsSupported(int type);
+    // "gzip", "gz", "zstd", "zst", TYPE_NONE if unknown.
+    static int TypeOf(const char* name);
+    static const char* Extension(int type);
+    static std::unique_ptr<Compressor> Create(FILE* fp, int type, int workers);
+
+    Compressor(FILE* fp) : fp_(fp), errors_(false) {}
+    virtual ~Compressor() {}
+    virtual bool Write(const uint8_t* buffer, size_t length) = 0;
+    // flush the end of stream, must be called before fclose.
+    virtual bool Finish() = 0;
+    inline bool Errors() { return errors_; }
+protected:
+    FILE* fp_;
+    bool errors_;
+};
+
+#endif  // UTILS_ZIP_COMPRESSOR_H_
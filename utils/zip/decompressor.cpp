@@ -0,0 +1,473 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "logger/log.h"
+#include "zip/decompressor.h"
+#include "zip/compressor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#if defined(__ZLIB__)
+#include <zlib.h>
+#endif // __ZLIB__
+
+#if defined(__ZSTD__)
+#include <zstd.h>
+#endif // __ZSTD__
+
+static inline uint32_t ReadLE32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+#if defined(__ZLIB__)
+class GzipDecompressor : public Decompressor {
+public:
+    GzipDecompressor(std::unique_ptr<MemoryMap>& input) : Decompressor(input) {}
+
+    bool Read(uint64_t off, uint8_t* buffer, uint64_t length) override {
+        if (off + length > size_)
+            return false;
+        if (!length)
+            return true;
+
+        auto it = std::upper_bound(points_.begin(), points_.end(), off,
+                [](uint64_t value, const Point& point) { return value < point.out; });
+        const Point& point = *(--it);
+
+        z_stream strm;
+        memset(&strm, 0, sizeof(strm));
+        bool raw = !point.header;
+        if (inflateInit2(&strm, raw ? -MAX_WBITS : 16 + MAX_WBITS) != Z_OK)
+            return false;
+
+        uint64_t pos = point.in;
+        if (point.bits) {
+            inflatePrime(&strm, point.bits, input()[point.in - 1] >> (8 - point.bits));
+        }
+        if (!point.window.empty())
+            inflateSetDictionary(&strm, point.window.data(), point.window.size());
+
+        std::vector<uint8_t> discard;
+        uint64_t skip = off - point.out;
+        uint64_t done = 0;
+        bool success = true;
+        while (done < length) {
+            uint64_t request;
+            if (skip) {
+                discard.resize(std::min(skip, kDiscardSize));
+                request = std::min(skip, kDiscardSize);
+                strm.next_out = discard.data();
+            } else {
+                request = std::min(length - done, kMaxAvail);
+                strm.next_out = buffer + done;
+            }
+            strm.avail_out = request;
+
+            if (!strm.avail_in) {
+                if (pos >= input_size()) {
+                    success = false;
+                    break;
+                }
+                strm.next_in = input() + pos;
+                strm.avail_in = std::min(input_size() - pos, kMaxAvail);
+                pos += strm.avail_in;
+            }
+
+            int ret = inflate(&strm, Z_NO_FLUSH);
+            uint64_t produced = request - strm.avail_out;
+            if (skip) {
+                skip -= produced;
+            } else {
+                done += produced;
+            }
+
+            if (ret == Z_STREAM_END) {
+                // concatenated members, a raw stream still owns its 8 bytes trailer.
+                uint64_t next = pos - strm.avail_in + (raw ? 8 : 0);
+                if (next >= input_size() || !IsMember(input() + next, input_size() - next)) {
+                    success = done == length;
+                    break;
+                }
+                inflateReset2(&strm, 16 + MAX_WBITS);
+                raw = false;
+                strm.avail_in = 0;
+                pos = next;
+            } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                success = false;
+                break;
+            }
+        }
+        inflateEnd(&strm);
+        return success;
+    }
+protected:
+    /*
+     * Walk the stream once and keep an access point at the first deflate
+     * block boundary past every kSpan output bytes, each point carries the
+     * last 32K of output as its dictionary.
+     */
+    bool BuildIndex() override {
+        z_stream strm;
+        memset(&strm, 0, sizeof(strm));
+        if (inflateInit2(&strm, 16 + MAX_WBITS) != Z_OK)
+            return false;
+
+        std::vector<uint8_t> window(kWindowSize);
+        points_.push_back({0, 0, 0, true, {}});
+        uint64_t pos = 0;
+        uint64_t totout = 0;
+        uint64_t next_point = kSpan;
+        bool success = true;
+        while (true) {
+            if (!strm.avail_out) {
+                strm.next_out = window.data();
+                strm.avail_out = window.size();
+            }
+            if (!strm.avail_in) {
+                if (pos >= input_size()) {
+                    // keep what was uploaded, reads past it fail as invalid memory.
+                    LOGW("Truncated gzip stream at %" PRIu64 ".\n", totout);
+                    break;
+                }
+                strm.next_in = input() + pos;
+                strm.avail_in = std::min(input_size() - pos, kMaxAvail);
+                pos += strm.avail_in;
+            }
+
+            uint32_t avail = strm.avail_out;
+            int ret = inflate(&strm, Z_BLOCK);
+            totout += avail - strm.avail_out;
+
+            if (ret == Z_STREAM_END) {
+                uint64_t next = pos - strm.avail_in;
+                if (next >= input_size() || !IsMember(input() + next, input_size() - next))
+                    break;
+                inflateReset(&strm);
+                strm.avail_in = 0;
+                pos = next;
+                points_.push_back({next, totout, 0, true, {}});
+                next_point = totout + kSpan;
+                continue;
+            }
+            if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                LOGE("Corrupt gzip stream at %" PRIu64 " (%s).\n", totout, strm.msg ? strm.msg : "unknown");
+                success = false;
+                break;
+            }
+
+            if ((strm.data_type & 128) && !(strm.data_type & 64) && totout >= next_point) {
+                Point point;
+                point.in = pos - strm.avail_in;
+                point.out = totout;
+                point.bits = strm.data_type & 7;
+                point.header = false;
+                // window is a ring, next_out is its oldest byte once full.
+                uint64_t head = window.size() - strm.avail_out;
+                point.window.reserve(kWindowSize);
+                point.window.insert(point.window.end(), window.begin() + head, window.end());
+                point.window.insert(point.window.end(), window.begin(), window.begin() + head);
+                points_.push_back(std::move(point));
+                next_point = totout + kSpan;
+            }
+        }
+        inflateEnd(&strm);
+        size_ = totout;
+        return success;
+    }
+private:
+    static constexpr uint64_t kWindowSize = 32 * 1024;
+    static constexpr uint64_t kDiscardSize = 256 * 1024;
+    static constexpr uint64_t kMaxAvail = 1UL << 30;
+
+    static bool IsMember(const uint8_t* p, uint64_t size) {
+        return size >= 2 && p[0] == 0x1F && p[1] == 0x8B;
+    }
+
+    struct Point {
+        // compressed offset of the first whole byte of the block.
+        uint64_t in;
+        uint64_t out;
+        // bits of the byte before in which belong to the block.
+        int bits;
+        // start of a gzip member, parse its header and no dictionary.
+        bool header;
+        std::vector<uint8_t> window;
+    };
+    std::vector<Point> points_;
+};
+#endif // __ZLIB__
+
+#if defined(__ZSTD__)
+class ZstdDecompressor : public Decompressor {
+public:
+    ZstdDecompressor(std::unique_ptr<MemoryMap>& input) : Decompressor(input) {}
+
+    bool Read(uint64_t off, uint8_t* buffer, uint64_t length) override {
+        if (off + length > size_)
+            return false;
+        if (!length)
+            return true;
+
+        auto it = std::upper_bound(frames_.begin(), frames_.end(), off,
+                [](uint64_t value, const Frame& frame) { return value < frame.out; });
+        --it;
+
+        ZSTD_DCtx* dctx = ZSTD_createDCtx();
+        if (!dctx)
+            return false;
+
+        std::vector<uint8_t> scratch;
+        uint64_t skip = off - it->out;
+        uint64_t done = 0;
+        for (; done < length && it != frames_.end(); ++it) {
+            uint64_t count = std::min(it->out_size - skip, length - done);
+            uint8_t* dst = buffer + done;
+            if (skip || count < it->out_size) {
+                scratch.resize(it->out_size);
+                dst = scratch.data();
+            }
+            size_t ret = ZSTD_decompressDCtx(dctx, dst, it->out_size, input() + it->in, it->in_size);
+            if (ZSTD_isError(ret) || ret != it->out_size)
+                break;
+            if (dst != buffer + done)
+                memcpy(buffer + done, dst + skip, count);
+            done += count;
+            skip = 0;
+        }
+        ZSTD_freeDCtx(dctx);
+        return done == length;
+    }
+protected:
+    bool BuildIndex() override {
+        if (ParseSeekTable())
+            return true;
+        frames_.clear();
+        size_ = 0;
+
+        bool independent = true;
+        uint64_t pos = 0;
+        while (pos < input_size()) {
+            size_t in_size = ZSTD_findFrameCompressedSize(input() + pos, input_size() - pos);
+            if (ZSTD_isError(in_size)) {
+                LOGE("Corrupt zstd stream at %" PRIx64 " (%s).\n", pos, ZSTD_getErrorName(in_size));
+                return false;
+            }
+            if ((ReadLE32(input() + pos) & 0xFFFFFFF0) != kSkippableMagic) {
+                unsigned long long out_size = ZSTD_getFrameContentSize(input() + pos, input_size() - pos);
+                if (out_size == ZSTD_CONTENTSIZE_UNKNOWN || out_size == ZSTD_CONTENTSIZE_ERROR
+                        || out_size > kMaxFrameSize) {
+                    independent = false;
+                    break;
+                }
+                frames_.push_back({pos, in_size, size_, out_size});
+                size_ += out_size;
+            }
+            pos += in_size;
+        }
+
+        if (independent)
+            return true;
+        return Transcode();
+    }
+private:
+    static constexpr uint32_t kSkippableMagic = 0x184D2A50;
+    static constexpr uint32_t kSeekTableMagic = 0x184D2A5E;
+    static constexpr uint32_t kSeekableMagic = 0x8F92EAB1;
+    static constexpr uint64_t kMaxFrameSize = 4 * kSpan;
+
+    // zstd seekable format, a skippable frame at the end lists every frame.
+    bool ParseSeekTable() {
+        constexpr uint64_t kFooterSize = 9;
+        if (input_size() < kFooterSize + 8)
+            return false;
+
+        const uint8_t* footer = input() + input_size() - kFooterSize;
+        if (ReadLE32(footer + 5) != kSeekableMagic)
+            return false;
+
+        uint64_t count = ReadLE32(footer);
+        uint64_t entry_size = (footer[4] & 0x80) ? 12 : 8;
+        uint64_t table_size = 8 + count * entry_size + kFooterSize;
+        if (table_size > input_size())
+            return false;
+
+        const uint8_t* table = input() + input_size() - table_size;
+        if (ReadLE32(table) != kSeekTableMagic)
+            return false;
+
+        uint64_t in = 0;
+        const uint8_t* entry = table + 8;
+        for (uint64_t i = 0; i < count; ++i, entry += entry_size) {
+            uint64_t in_size = ReadLE32(entry);
+            uint64_t out_size = ReadLE32(entry + 4);
+            if (out_size > kMaxFrameSize) {
+                LOGW("Seek table frame %" PRIu64 " too large, walk frames.\n", i);
+                return false;
+            }
+            frames_.push_back({in, in_size, size_, out_size});
+            in += in_size;
+            size_ += out_size;
+        }
+        // the frames and the table must cover the whole file.
+        if (in != input_size() - table_size) {
+            LOGW("Seek table doesn't match file size, walk frames.\n");
+            return false;
+        }
+        return true;
+    }
+
+    /*
+     * A single frame has no resumable point, so a legacy stream is decoded
+     * once and re-encoded into kSpan sized frames in an unlinked temp file,
+     * which costs about the compressed size on disk instead of the core size.
+     */
+    bool Transcode() {
+        frames_.clear();
+        size_ = 0;
+
+        const char* tmpdir = getenv("TMPDIR");
+        std::string path = std::string(tmpdir ? tmpdir : "/tmp") + "/core-parser-XXXXXX";
+        int fd = mkstemp(path.data());
+        if (fd == -1) {
+            LOGE("Can't create temp file \"%s\".\n", path.c_str());
+            return false;
+        }
+        FILE* fp = fdopen(fd, "wb");
+        if (!fp) {
+            close(fd);
+            unlink(path.c_str());
+            return false;
+        }
+
+        LOGI("Indexing non-seekable zstd stream ...\n");
+        ZSTD_DStream* dstream = ZSTD_createDStream();
+        ZSTD_CCtx* cctx = ZSTD_createCCtx();
+        std::vector<uint8_t> chunk(kSpan);
+        std::vector<uint8_t> frame(ZSTD_compressBound(kSpan));
+        ZSTD_inBuffer input_buffer = { input(), input_size(), 0 };
+        ZSTD_outBuffer output_buffer = { chunk.data(), chunk.size(), 0 };
+        uint64_t in = 0;
+        bool success = dstream && cctx;
+        if (success)
+            ZSTD_initDStream(dstream);
+
+        while (success) {
+            size_t in_pos = input_buffer.pos;
+            size_t out_pos = output_buffer.pos;
+            size_t ret = ZSTD_decompressStream(dstream, &output_buffer, &input_buffer);
+            if (ZSTD_isError(ret)) {
+                LOGE("Corrupt zstd stream (%s).\n", ZSTD_getErrorName(ret));
+                success = false;
+                break;
+            }
+            // all input consumed and nothing left to flush, or a truncated tail.
+            bool eof = input_buffer.pos == input_buffer.size
+                    && (!ret || (input_buffer.pos == in_pos && output_buffer.pos == out_pos));
+            if (output_buffer.pos == output_buffer.size || (eof && output_buffer.pos)) {
+                size_t in_size = ZSTD_compressCCtx(cctx, frame.data(), frame.size(),
+                                                   chunk.data(), output_buffer.pos, 1);
+                if (ZSTD_isError(in_size) || !fwrite(frame.data(), in_size, 1, fp)) {
+                    success = false;
+                    break;
+                }
+                frames_.push_back({in, in_size, size_, output_buffer.pos});
+                in += in_size;
+                size_ += output_buffer.pos;
+                output_buffer.pos = 0;
+            }
+            if (eof) {
+                if (ret)
+                    LOGW("Truncated zstd stream at %" PRIu64 ".\n", size_);
+                break;
+            }
+        }
+
+        if (dstream) ZSTD_freeDStream(dstream);
+        if (cctx) ZSTD_freeCCtx(cctx);
+        success &= !fclose(fp);
+        if (success) {
+            input_.reset(MemoryMap::MmapFile(path.c_str()));
+            success = input_ != nullptr || !in;
+        }
+        unlink(path.c_str());
+        return success;
+    }
+
+    struct Frame {
+        uint64_t in;
+        uint64_t in_size;
+        uint64_t out;
+        uint64_t out_size;
+    };
+    std::vector<Frame> frames_;
+};
+#endif // __ZSTD__
+
+int Decompressor::TypeOf(const char* file) {
+    int fd = open(file, O_RDONLY);
+    if (fd == -1)
+        return Compressor::TYPE_NONE;
+
+    uint8_t magic[4];
+    int type = Compressor::TYPE_NONE;
+    if (read(fd, magic, sizeof(magic)) == sizeof(magic)) {
+        if (magic[0] == 0x1F && magic[1] == 0x8B) {
+            type = Compressor::TYPE_GZIP;
+        } else if (ReadLE32(magic) == 0xFD2FB528) {
+            type = Compressor::TYPE_ZSTD;
+        }
+    }
+    close(fd);
+    return type;
+}
+
+std::unique_ptr<Decompressor> Decompressor::Open(const char* file) {
+    std::unique_ptr<Decompressor> decompressor;
+    int type = TypeOf(file);
+    if (!Compressor::IsSupported(type)) {
+        LOGE("Not support decompress \"%s\", rebuild with zlib or libzstd.\n", file);
+        return decompressor;
+    }
+
+    std::unique_ptr<MemoryMap> input(MemoryMap::MmapFile(file));
+    if (!input)
+        return decompressor;
+
+    switch (type) {
+#if defined(__ZLIB__)
+        case Compressor::TYPE_GZIP:
+            decompressor = std::make_unique<GzipDecompressor>(input);
+            break;
+#endif // __ZLIB__
+#if defined(__ZSTD__)
+        case Compressor::TYPE_ZSTD:
+            decompressor = std::make_unique<ZstdDecompressor>(input);
+            break;
+#endif // __ZSTD__
+    }
+
+    if (decompressor && !decompressor->BuildIndex())
+        decompressor.reset();
+    return decompressor;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UTILS_ZIP_DECOMPRESSOR_H_
+#define UTILS_ZIP_DECOMPRESSOR_H_
+
+#include "base/memory_map.h"
+#include <stdint.h>
+#include <sys/types.h>
+#include <memory>
+
+/*
+ * Random access reader over a compressed file (.gz or .zst).
+ * Open builds a seek index once, seekable zstd reuses its seek table,
+ * otherwise the whole stream is walked a single time. Read then only
+ * decodes from the nearest access point before the requested offset.
+ */
+class Decompressor {
+public:
+    // Compressor::TYPE_GZIP, TYPE_ZSTD by magic, TYPE_NONE otherwise.
+    static int TypeOf(const char* file);
+    static std::unique_ptr<Decompressor> Open(const char* file);
+
+    Decompressor(std::unique_ptr<MemoryMap>& input) : input_(std::move(input)), size_(0) {}
+    virtual ~Decompressor() {}
+    // thread safe, false if the stream is corrupt or ends before off + length.
+    virtual bool Read(uint64_t off, uint8_t* buffer, uint64_t length) = 0;
+    inline uint64_t size() { return size_; }
+protected:
+    virtual bool BuildIndex() = 0;
+    inline uint8_t* input() { return reinterpret_cast<uint8_t *>(input_->data()); }
+    inline uint64_t input_size() { return input_->realSize(); }
+
+    // distance between access points in the decompressed stream.
+    static constexpr uint64_t kSpan = 4 * 1024 * 1024;
+    std::unique_ptr<MemoryMap> input_;
+    uint64_t size_;
+};
+
+#endif  // UTILS_ZIP_DECOMPRESSOR_H_
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logger/log.h"
+#include "zip/xz.h"
+
+#if defined(__LZMA__)
+#include <lzma.h>
+#endif // __LZMA__
+
+bool Xz::IsSupported() {
+#if defined(__LZMA__)
+    return true;
+#else
+    return false;
+#endif // __LZMA__
+}
+
+bool Xz::Decompress(const uint8_t* data, uint64_t size, std::vector<uint8_t>& out) {
+#if defined(__LZMA__)
+    if (!data || !size)
+        return false;
+
+    lzma_stream strm = LZMA_STREAM_INIT;
+    if (lzma_stream_decoder(&strm, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK)
+        return false;
+
+    out.resize(size * 4);
+    strm.next_in = data;
+    strm.avail_in = size;
+    strm.next_out = out.data();
+    strm.avail_out = out.size();
+
+    lzma_ret ret;
+    do {
+        if (!strm.avail_out) {
+            uint64_t pos = out.size();
+            out.resize(pos * 2);
+            strm.next_out = out.data() + pos;
+            strm.avail_out = out.size() - pos;
+        }
+        ret = lzma_code(&strm, LZMA_FINISH);
+    } while (ret == LZMA_OK);
+
+    out.resize(strm.total_out);
+    lzma_end(&strm);
+
+    if (ret != LZMA_STREAM_END) {
+        LOGE("xz decompress fail(%d)\n", ret);
+        out.clear();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif // __LZMA__
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2024-present, Guanyou.Chen. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_ZIP_XZ_H_
+#define UTILS_ZIP_XZ_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <vector>
+
+class Xz {
+public:
+    // false if build without liblzma
+    static bool IsSupported();
+    static bool Decompress(const uint8_t* data, uint64_t size, std::vector<uint8_t>& out);
+};
+
+#endif  // UTILS_ZIP_XZ_H_